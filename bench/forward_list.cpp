@@ -0,0 +1,83 @@
+#include "helpers/benchmark.h"
+#include "../list/forward_list.h"
+
+int main(int argc, char** argv)
+{
+	const std::size_t elements = bench::elementsFromArgs(argc, argv, std::size_t(1) << 21);
+
+	std::cout << "forward_list vs list over " << elements << " elements\n";
+
+	const std::size_t listBytes = bench::heapGrowth([&]
+		{
+			list<int> built;
+			for (std::size_t i = 0; i < elements; i++)
+				built.push_back(int(i));
+			return built;
+		});
+	const std::size_t forwardBytes = bench::heapGrowth([&]
+		{
+			forward_list<int> built;
+			for (std::size_t i = 0; i < elements; i++)
+				built.push_back(int(i));
+			return built;
+		});
+
+	std::cout << "list<int> heap bytes/element:         " << double(listBytes) / double(elements) << '\n';
+	std::cout << "forward_list<int> heap bytes/element: " << double(forwardBytes) / double(elements) << '\n';
+
+	bench::run("list queue (push_back + pop_front)", elements, [&]
+		{
+			list<int> queue;
+			for (int i = 0; i < 64; i++)
+				queue.push_back(i);
+			for (std::size_t i = 0; i < elements; i++)
+			{
+				queue.push_back(int(i));
+				queue.pop_front();
+			}
+			return queue.size();
+		});
+	bench::run("forward_list queue (push_back + pop_front)", elements, [&]
+		{
+			forward_list<int> queue;
+			for (int i = 0; i < 64; i++)
+				queue.push_back(i);
+			for (std::size_t i = 0; i < elements; i++)
+			{
+				queue.push_back(int(i));
+				queue.pop_front();
+			}
+			return queue.size();
+		});
+
+	std::vector<int> values(elements);
+	for (std::size_t i = 0; i < elements; i++)
+		values[i] = int(i);
+	std::shuffle(values.begin(), values.end(), std::mt19937(42));
+
+	list<int> plain;
+	forward_list<int> single;
+	for (int e : values)
+	{
+		plain.push_back(e);
+		single.push_back(e);
+	}
+
+	bench::run("list accumulate", elements, [&] { return plain.accumulate(0LL); });
+	bench::run("forward_list accumulate", elements, [&] { return single.accumulate(0LL); });
+
+	bench::run("list sort (quicksort)", 2048, [&]
+		{
+			list<int> sorted;
+			for (std::size_t i = 0; i < 2048; i++)
+				sorted.push_back(values[i]);
+			sorted.sort();
+			return sorted.front();
+		});
+	bench::run("forward_list sort (merge sort)", elements, [&]
+		{
+			forward_list<int> sorted = single;
+			sorted.sort();
+			return sorted.front();
+		});
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include "../../list/list.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace bench
+{
+	inline std::size_t sink = 0;
+
+	template<class Function>
+	double measure(Function function, int repetitions = 5)
+	{
+		double best = 0;
+		for (int i = 0; i < repetitions; i++)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			sink += static_cast<std::size_t>(function());
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+			if (i == 0 || elapsed.count() < best)
+				best = elapsed.count();
+		}
+		return best;
+	}
+
+	inline void report(const std::string& name, double seconds, std::size_t elements)
+	{
+		std::cout << std::left << std::setw(40) << name
+			<< std::right << std::setw(12) << std::fixed << std::setprecision(3)
+			<< seconds * 1e9 / double(elements) << " ns/element\n";
+	}
+
+	template<class Function>
+	void run(const std::string& name, std::size_t elements, Function function)
+	{
+		report(name, measure(function), elements);
+	}
+
+	inline std::size_t elementsFromArgs(int argc, char** argv, std::size_t fallback)
+	{
+		return argc > 1 ? std::stoull(argv[1]) : fallback;
+	}
+
+	inline std::size_t heapBytes()
+	{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+		return mallinfo2().uordblks;
+#else
+		return 0;
+#endif
+	}
+
+	template<class Build>
+	std::size_t heapGrowth(Build build)
+	{
+		const std::size_t before = heapBytes();
+		auto built = build();
+		const std::size_t after = heapBytes();
+		sink += built.size();
+		return after - before;
+	}
+
+	template<typename T>
+	list<T> makeShuffled(std::size_t elements, unsigned seed = 42)
+	{
+		list<T> sequential;
+		for (std::size_t i = 0; i < elements; i++)
+			sequential.emplace_back(static_cast<T>(i));
+
+		std::vector<typename list<T>::node_handle> handles;
+		handles.reserve(elements);
+		while (!sequential.empty())
+			handles.push_back(sequential.extract(sequential.begin()));
+
+		std::shuffle(handles.begin(), handles.end(), std::mt19937(seed));
+
+		list<T> shuffled;
+		for (auto& handle : handles)
+			shuffled.insert(shuffled.end(), std::move(handle));
+		return shuffled;
+	}
+}
@@ -0,0 +1,184 @@
+#pragma once
+#include "benchmark.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench
+{
+	enum class hardware_event
+	{
+		instructions,
+		l1d_misses,
+		llc_misses,
+		dtlb_misses,
+		branch_misses
+	};
+
+	inline constexpr std::size_t hardware_event_count = 5;
+
+	inline const char* event_name(hardware_event event)
+	{
+		switch (event)
+		{
+		case hardware_event::instructions: return "instr";
+		case hardware_event::l1d_misses: return "L1d-miss";
+		case hardware_event::llc_misses: return "LLC-miss";
+		case hardware_event::dtlb_misses: return "dTLB-miss";
+		case hardware_event::branch_misses: return "br-miss";
+		}
+		return "?";
+	}
+
+	struct counter_sample
+	{
+		double seconds = 0;
+		std::array<std::uint64_t, hardware_event_count> values{};
+		std::array<bool, hardware_event_count> valid{};
+	};
+
+	class perf_counters
+	{
+	private:
+		std::array<int, hardware_event_count> fds;
+
+#if defined(__linux__)
+		static constexpr std::uint64_t cacheConfig(std::uint64_t cache, std::uint64_t op, std::uint64_t result)
+		{
+			return cache | (op << 8) | (result << 16);
+		}
+
+		static int open(std::uint32_t type, std::uint64_t config)
+		{
+			perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = type;
+			attr.config = config;
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+		}
+#endif
+
+	public:
+		perf_counters()
+		{
+			fds.fill(-1);
+#if defined(__linux__)
+			fds[std::size_t(hardware_event::instructions)] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+			fds[std::size_t(hardware_event::l1d_misses)] = open(PERF_TYPE_HW_CACHE,
+				cacheConfig(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS));
+			fds[std::size_t(hardware_event::llc_misses)] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+			fds[std::size_t(hardware_event::dtlb_misses)] = open(PERF_TYPE_HW_CACHE,
+				cacheConfig(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS));
+			fds[std::size_t(hardware_event::branch_misses)] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+		}
+
+		perf_counters(const perf_counters&) = delete;
+		perf_counters& operator=(const perf_counters&) = delete;
+
+		~perf_counters()
+		{
+#if defined(__linux__)
+			for (int fd : fds)
+				if (fd >= 0)
+					::close(fd);
+#endif
+		}
+
+		[[nodiscard]] bool available(hardware_event event) const
+		{
+			return fds[std::size_t(event)] >= 0;
+		}
+
+		[[nodiscard]] bool any_available() const
+		{
+			for (int fd : fds)
+				if (fd >= 0)
+					return true;
+			return false;
+		}
+
+		static std::string unavailable_reason()
+		{
+#if defined(__linux__)
+			std::ifstream paranoid("/proc/sys/kernel/perf_event_paranoid");
+			int level = 0;
+			if (paranoid >> level)
+				return "perf_event_open failed (perf_event_paranoid=" + std::to_string(level) + ")";
+			return "perf_event_open is not supported here";
+#else
+			return "hardware counters need Linux perf_event_open";
+#endif
+		}
+
+		template<class Function>
+		counter_sample measure(Function function)
+		{
+			counter_sample sample;
+#if defined(__linux__)
+			for (int fd : fds)
+				if (fd >= 0)
+				{
+					::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+					::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+				}
+#endif
+			const auto start = std::chrono::steady_clock::now();
+			sink += static_cast<std::size_t>(function());
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+#if defined(__linux__)
+			for (std::size_t i = 0; i < hardware_event_count; i++)
+				if (fds[i] >= 0)
+				{
+					::ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+					std::array<std::uint64_t, 3> reading{};
+					sample.valid[i] = ::read(fds[i], reading.data(), sizeof(reading)) == sizeof(reading) && reading[2] > 0;
+					if (sample.valid[i])
+						sample.values[i] = static_cast<std::uint64_t>(double(reading[0]) * double(reading[1]) / double(reading[2]));
+				}
+#endif
+			sample.seconds = elapsed.count();
+			return sample;
+		}
+	};
+
+	inline void report_header()
+	{
+		std::cout << std::left << std::setw(36) << "per element"
+			<< std::right << std::setw(10) << "ns";
+		for (std::size_t i = 0; i < hardware_event_count; i++)
+			std::cout << std::setw(11) << event_name(hardware_event(i));
+		std::cout << '\n';
+	}
+
+	inline void report(const std::string& name, const counter_sample& sample, std::size_t elements)
+	{
+		const double n = double(elements);
+		std::cout << std::left << std::setw(36) << name
+			<< std::right << std::setw(10) << std::fixed << std::setprecision(2) << sample.seconds * 1e9 / n;
+		for (std::size_t i = 0; i < hardware_event_count; i++)
+		{
+			if (sample.valid[i])
+				std::cout << std::setw(11) << std::setprecision(3) << double(sample.values[i]) / n;
+			else
+				std::cout << std::setw(11) << "n/a";
+		}
+		std::cout << '\n';
+	}
+}
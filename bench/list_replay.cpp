@@ -0,0 +1,285 @@
+#include "helpers/benchmark.h"
+#include "../list/index_list.h"
+#include "../list/list_trace.h"
+#include <array>
+#include <fstream>
+#include <list>
+#include <sstream>
+
+namespace
+{
+	using list_stats::trace_event;
+	using list_stats::trace_op;
+
+	const char* opName(trace_op op)
+	{
+		static constexpr std::array<const char*, list_stats::trace_op_count> names = {
+			"push_back", "push_front", "insert", "pop_back", "pop_front", "erase",
+			"erase_range", "splice", "clear", "remove_if", "sort", "traverse"
+		};
+		return names[std::size_t(op)];
+	}
+
+	std::vector<trace_event> loadTrace(std::istream& stream)
+	{
+		list_trace::reader in(stream);
+		std::vector<trace_event> events;
+		trace_event event{};
+		while (in.next(event))
+			events.push_back(event);
+		return events;
+	}
+
+	std::string synthesizeTrace(std::size_t operations)
+	{
+		std::ostringstream stream;
+		list_trace::writer out(stream);
+		list_trace::recorded_list<int> target;
+		target.recorder().attach(out);
+
+		std::mt19937 generator(7);
+		auto positionIn = [&](std::size_t size) { return std::uniform_int_distribution<std::size_t>(0, size)(generator); };
+
+		for (int i = 0; i < 4096; i++)
+			target.push_back(i);
+
+		for (std::size_t i = 0; i < operations; i++)
+		{
+			const unsigned roll = target.size() > 8192 ? 400 : generator() % 1000;
+			if (roll < 300)
+				target.push_back(int(i));
+			else if (roll < 550 && target.size() > 64)
+				target.pop_front();
+			else if (roll < 700)
+				target.emplace(std::next(target.begin(), std::ptrdiff_t(positionIn(target.size()) % 64)), int(i));
+			else if (roll < 850 && target.size() > 64)
+				target.pop(std::prev(target.end(), std::ptrdiff_t(positionIn(63) + 1)));
+			else if (roll < 900)
+			{
+				list_trace::recorded_list<int> batch;
+				for (int k = 0; k < 32; k++)
+					batch.push_back(k);
+				target.splice(target.begin(), batch);
+			}
+			else if (roll < 990)
+				(void)target.contains(-1);
+			else if (roll < 998)
+				target.remove_if([](int e) { return e % 16 == 0; });
+			else
+				target.merge_sort();
+		}
+		out.close();
+		return stream.str();
+	}
+
+	template<class Container>
+	auto positionAt(Container& target, std::size_t index)
+	{
+		const std::size_t size = target.size();
+		index = std::min(index, size);
+		if (index <= size / 2)
+			return std::next(target.begin(), std::ptrdiff_t(index));
+		return std::prev(target.end(), std::ptrdiff_t(size - index));
+	}
+
+	template<class Container>
+	void spliceAt(Container& target, std::size_t index, Container& batch)
+	{
+		if constexpr (requires { target.splice(target.begin(), batch, batch.begin()); })
+			target.splice(positionAt(target, index), batch);
+		else
+			target.splice(index == 0 ? target.end() : positionAt(target, index - 1), batch);
+	}
+
+	template<class Container>
+	void sortAll(Container& target)
+	{
+		if constexpr (requires { target.merge_sort(); })
+			target.merge_sort();
+		else
+			target.sort();
+	}
+
+	template<class Container>
+	void eraseAt(Container& target, std::size_t index)
+	{
+		if constexpr (requires { target.pop(target.begin()); })
+			target.pop(positionAt(target, index));
+		else
+			target.erase(positionAt(target, index));
+	}
+
+	template<class Container>
+	std::size_t apply(Container& target, const trace_event& event, int value)
+	{
+		const auto count = std::size_t(event.count);
+		switch (event.op)
+		{
+		case trace_op::push_back:
+			for (std::size_t i = 0; i < count; i++)
+				target.push_back(value);
+			break;
+		case trace_op::push_front:
+			target.push_front(value);
+			break;
+		case trace_op::insert:
+			target.insert(positionAt(target, std::size_t(event.index)), value);
+			break;
+		case trace_op::pop_back:
+			if (!target.empty())
+				target.pop_back();
+			break;
+		case trace_op::pop_front:
+			if (!target.empty())
+				target.pop_front();
+			break;
+		case trace_op::erase:
+			if (event.index < target.size())
+				eraseAt(target, std::size_t(event.index));
+			break;
+		case trace_op::erase_range:
+		{
+			const std::size_t first = std::min(std::size_t(event.index), target.size());
+			const std::size_t last = std::min(first + count, target.size());
+			target.erase(positionAt(target, first), positionAt(target, last));
+			break;
+		}
+		case trace_op::splice:
+			break;
+		case trace_op::clear:
+			target.clear();
+			break;
+		case trace_op::remove_if:
+		{
+			const std::size_t total = std::max<std::size_t>(target.size(), 1);
+			std::size_t seen = 0;
+			std::size_t removed = 0;
+			target.remove_if([&](const int&)
+				{
+					const bool take = removed < (++seen * count) / total;
+					removed += take;
+					return take;
+				});
+			break;
+		}
+		case trace_op::sort:
+			sortAll(target);
+			break;
+		case trace_op::traverse:
+		{
+			std::size_t walked = 0;
+			long long total = 0;
+			if constexpr (requires { target.find_if([](const int&) { return true; }); })
+				(void)target.find_if([&](const int& e) { total += e; return ++walked == count; });
+			else
+				for (auto it = target.begin(), last = target.end(); walked < count && it != last; ++it, ++walked)
+					total += *it;
+			return std::size_t(total);
+		}
+		}
+		return target.size();
+	}
+
+	struct replay_result
+	{
+		double seconds = 0;
+		std::vector<std::uint64_t> latencies;
+		std::array<double, list_stats::trace_op_count> secondsByOp{};
+	};
+
+	template<class Container>
+	replay_result replay(const std::vector<trace_event>& events)
+	{
+		replay_result result;
+		result.latencies.reserve(events.size());
+		Container target;
+		int value = 0;
+
+		for (const trace_event& event : events)
+		{
+			Container batch;
+			if (event.op == trace_op::splice)
+				for (std::uint64_t i = 0; i < event.count; i++)
+					batch.push_back(value++);
+
+			const auto start = std::chrono::steady_clock::now();
+			if (event.op == trace_op::splice)
+				spliceAt(target, std::size_t(std::min<std::uint64_t>(event.index, target.size())), batch);
+			else
+				bench::sink += apply(target, event, value++);
+			const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+			result.latencies.push_back(std::uint64_t(elapsed.count()));
+			result.secondsByOp[std::size_t(event.op)] += double(elapsed.count()) * 1e-9;
+			result.seconds += double(elapsed.count()) * 1e-9;
+		}
+
+		bench::sink += target.size();
+		return result;
+	}
+
+	void report(const std::string& name, replay_result result)
+	{
+		std::sort(result.latencies.begin(), result.latencies.end());
+		auto percentile = [&](double fraction)
+			{
+				if (result.latencies.empty())
+					return std::uint64_t(0);
+				return result.latencies[std::size_t(fraction * double(result.latencies.size() - 1))];
+			};
+
+		std::cout << std::left << std::setw(16) << name
+			<< std::right << std::setw(14) << std::fixed << std::setprecision(0) << double(result.latencies.size()) / result.seconds
+			<< std::setw(10) << percentile(0.5)
+			<< std::setw(10) << percentile(0.9)
+			<< std::setw(10) << percentile(0.99)
+			<< std::setw(10) << percentile(0.999)
+			<< std::setw(12) << (result.latencies.empty() ? 0 : result.latencies.back()) << '\n';
+
+		std::cout << "  time by op:";
+		for (std::size_t i = 0; i < list_stats::trace_op_count; i++)
+			if (result.secondsByOp[i] > 0)
+				std::cout << ' ' << opName(trace_op(i)) << '=' << std::setprecision(1) << result.secondsByOp[i] * 1e3 << "ms";
+		std::cout << '\n';
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<trace_event> events;
+	if (argc > 1)
+	{
+		std::ifstream file(argv[1], std::ios::binary);
+		if (!file)
+		{
+			std::cerr << "cannot open trace " << argv[1] << '\n';
+			return 1;
+		}
+		events = loadTrace(file);
+		std::cout << "replaying " << events.size() << " operations from " << argv[1] << '\n';
+	}
+	else
+	{
+		std::istringstream stream(synthesizeTrace(50000));
+		events = loadTrace(stream);
+		std::cout << "replaying " << events.size() << " operations from a synthetic trace (pass a trace file to replay a capture)\n";
+	}
+
+	std::array<std::size_t, list_stats::trace_op_count> mix{};
+	for (const trace_event& event : events)
+		++mix[std::size_t(event.op)];
+	std::cout << "mix:";
+	for (std::size_t i = 0; i < mix.size(); i++)
+		if (mix[i])
+			std::cout << ' ' << opName(trace_op(i)) << '=' << mix[i];
+	std::cout << "\n\n";
+
+	std::cout << std::left << std::setw(16) << "layout"
+		<< std::right << std::setw(14) << "ops/s"
+		<< std::setw(10) << "p50 ns" << std::setw(10) << "p90 ns" << std::setw(10) << "p99 ns"
+		<< std::setw(10) << "p999 ns" << std::setw(12) << "max ns" << '\n';
+
+	report("list", replay<list<int>>(events));
+	report("std::list", replay<std::list<int>>(events));
+	report("index_list", replay<index_list<int>>(events));
+}
@@ -0,0 +1,70 @@
+#include "helpers/perf_counters.h"
+
+int main(int argc, char** argv)
+{
+	const std::size_t elements = bench::elementsFromArgs(argc, argv, std::size_t(1) << 21);
+	const std::size_t sortElements = std::min<std::size_t>(elements, 2048);
+	bench::perf_counters counters;
+
+	std::cout << "hardware counters over " << elements << " elements\n";
+	if (!counters.any_available())
+		std::cout << "counters unavailable, reporting wall clock only: " << bench::perf_counters::unavailable_reason() << '\n';
+	bench::report_header();
+
+	list<int> sequential;
+	for (std::size_t i = 0; i < elements; i++)
+		sequential.push_back(int(i));
+	list<int> shuffled = bench::makeShuffled<int>(elements);
+
+	bench::report("traverse sequential accumulate", counters.measure([&] { return sequential.accumulate(0LL); }), elements);
+	bench::report("traverse shuffled accumulate", counters.measure([&] { return shuffled.accumulate(0LL); }), elements);
+	bench::report("traverse shuffled accumulate<8>", counters.measure([&] { return shuffled.accumulate<8>(0LL); }), elements);
+	bench::report("traverse shuffled range-for", counters.measure([&]
+		{
+			long long total = 0;
+			for (int e : shuffled)
+				total += e;
+			return total;
+		}), elements);
+
+	{
+		list<int> target = bench::makeShuffled<int>(elements);
+		bench::report("merge_sort shuffled", counters.measure([&] { target.merge_sort(); return target.size(); }), elements);
+		bench::report("merge_sort already sorted", counters.measure([&] { target.merge_sort(); return target.size(); }), elements);
+	}
+
+	{
+		list<int> target = bench::makeShuffled<int>(elements);
+		bench::report("radix_sort shuffled", counters.measure([&] { target.radix_sort(); return target.size(); }), elements);
+	}
+
+	{
+		list<int> target = bench::makeShuffled<int>(sortElements);
+		bench::report("sort (n=" + std::to_string(sortElements) + ")", counters.measure([&] { target.sort(); return target.size(); }), sortElements);
+	}
+
+	{
+		list<int> target = bench::makeShuffled<int>(elements);
+		bench::report("remove_if shuffled (half)", counters.measure([&] { return target.remove_if([](int e) { return e % 2 == 0; }); }), elements);
+	}
+
+	{
+		list<int> target = sequential;
+		bench::report("remove_if sequential (half)", counters.measure([&] { return target.remove_if([](int e) { return e % 2 == 0; }); }), elements);
+	}
+
+	{
+		const std::size_t chunk = 1024;
+		std::vector<list<int>> pieces(elements / chunk + 1);
+		for (std::size_t i = 0; i < elements; i++)
+			pieces[i / chunk].push_back(int(i));
+
+		list<int> target;
+		bench::report("splice 1024-element chunks", counters.measure([&]
+			{
+				for (auto& piece : pieces)
+					target.splice(target.end(), piece);
+				return target.size();
+			}), elements);
+	}
+}
@@ -0,0 +1,67 @@
+#include "helpers/benchmark.h"
+#include "../list/serialization.h"
+#include <cstdio>
+#include <sstream>
+
+int main(int argc, char** argv)
+{
+	const std::size_t elements = bench::elementsFromArgs(argc, argv, std::size_t(1) << 22);
+
+	std::cout << "list serialization over " << elements << " elements\n";
+
+	list<int> values;
+	for (std::size_t i = 0; i < elements; i++)
+		values.push_back(int(i * 7));
+
+	list<double> reals;
+	for (std::size_t i = 0; i < elements; i++)
+		reals.push_back(double(i) * 0.5);
+
+	std::stringstream text;
+	values.for_each([&](int e) { text << e << '\n'; });
+	const std::string textDump = text.str();
+
+	std::FILE* intFile = std::tmpfile();
+	std::FILE* realFile = std::tmpfile();
+	const int intFd = fileno(intFile);
+	const int realFd = fileno(realFile);
+	list_io::save(values, intFd);
+	list_io::save(reals, realFd);
+
+	std::cout << "text dump bytes/element:         " << double(textDump.size()) / double(elements) << '\n';
+	std::cout << "delta varint bytes/element:      " << double(lseek(intFd, 0, SEEK_END)) / double(elements) << '\n';
+	std::cout << "raw double bytes/element:        " << double(lseek(realFd, 0, SEEK_END)) / double(elements) << '\n';
+
+	bench::run("text parse + push_back", elements, [&]
+		{
+			std::istringstream in(textDump);
+			list<int> loaded;
+			int e;
+			while (in >> e)
+				loaded.push_back(e);
+			return loaded.size();
+		});
+	bench::run("save delta varint (fd)", elements, [&]
+		{
+			lseek(intFd, 0, SEEK_SET);
+			list_io::save(values, intFd);
+			return values.size();
+		});
+	bench::run("load delta varint (fd)", elements, [&]
+		{
+			lseek(intFd, 0, SEEK_SET);
+			list<int> loaded;
+			list_io::load(loaded, intFd);
+			return loaded.size();
+		});
+	bench::run("load raw double (fd)", elements, [&]
+		{
+			lseek(realFd, 0, SEEK_SET);
+			list<double> loaded;
+			list_io::load(loaded, realFd);
+			return loaded.size();
+		});
+
+	std::fclose(intFile);
+	std::fclose(realFile);
+}
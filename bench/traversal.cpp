@@ -0,0 +1,67 @@
+#include "helpers/benchmark.h"
+#include "../list/index_list.h"
+
+int main(int argc, char** argv)
+{
+	const std::size_t elements = bench::elementsFromArgs(argc, argv, std::size_t(1) << 21);
+	list<int> shuffled = bench::makeShuffled<int>(elements);
+	const int missing = -1;
+
+	std::cout << "traversal over " << elements << " shuffled nodes\n";
+
+	bench::run("range-for iterator sum", elements, [&]
+		{
+			long long total = 0;
+			for (int e : shuffled)
+				total += e;
+			return total;
+		});
+
+	bench::run("accumulate (no prefetch)", elements, [&] { return shuffled.accumulate(0LL); });
+	bench::run("accumulate<4>", elements, [&] { return shuffled.accumulate<4>(0LL); });
+	bench::run("accumulate<8>", elements, [&] { return shuffled.accumulate<8>(0LL); });
+	bench::run("accumulate<16>", elements, [&] { return shuffled.accumulate<16>(0LL); });
+	bench::run("sum (gather + simd)", elements, [&] { return shuffled.sum(); });
+
+	auto heavyPredicate = [](int e)
+		{
+			unsigned hash = static_cast<unsigned>(e);
+			for (int round = 0; round < 64; round++)
+				hash = hash * 2654435761u + 0x9e3779b9u;
+			return (hash & 1) == 0;
+		};
+
+	bench::run("range-for iterator count (heavy)", elements, [&]
+		{
+			std::size_t total = 0;
+			for (int e : shuffled)
+				total += heavyPredicate(e);
+			return total;
+		});
+
+	bench::run("count_if (heavy)", elements, [&] { return shuffled.count_if(heavyPredicate); });
+	bench::run("count_if<8> (heavy)", elements, [&] { return shuffled.count_if<8>(heavyPredicate); });
+
+	bench::run("range-for iterator find (miss)", elements, [&]
+		{
+			for (int e : shuffled)
+				if (e == missing)
+					return true;
+			return false;
+		});
+
+	bench::run("contains (miss)", elements, [&] { return shuffled.contains(missing); });
+	bench::run("contains<8> (miss)", elements, [&] { return shuffled.contains<8>(missing); });
+
+	std::cout << "locality score before defragment: " << shuffled.locality_score() << '\n';
+	shuffled.defragment();
+	std::cout << "locality score after defragment: " << shuffled.locality_score() << '\n';
+
+	bench::run("accumulate after defragment", elements, [&] { return shuffled.accumulate(0LL); });
+	bench::run("accumulate<8> after defragment", elements, [&] { return shuffled.accumulate<8>(0LL); });
+
+	index_list<int> indexed;
+	for (int e : shuffled)
+		indexed.push_back(e);
+	bench::run("index_list accumulate", elements, [&] { return indexed.accumulate(0LL); });
+}
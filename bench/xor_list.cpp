@@ -0,0 +1,74 @@
+#include "helpers/benchmark.h"
+#include "../list/xor_list.h"
+
+int main(int argc, char** argv)
+{
+	const std::size_t elements = bench::elementsFromArgs(argc, argv, std::size_t(1) << 21);
+
+	std::cout << "xor_list vs list over " << elements << " elements\n";
+
+	const std::size_t listBytes = bench::heapGrowth([&]
+		{
+			list<int> built;
+			for (std::size_t i = 0; i < elements; i++)
+				built.push_back(int(i));
+			return built;
+		});
+	const std::size_t xorBytes = bench::heapGrowth([&]
+		{
+			xor_list<int> built;
+			for (std::size_t i = 0; i < elements; i++)
+				built.push_back(int(i));
+			return built;
+		});
+
+	std::cout << "list<int> heap bytes/element:     " << double(listBytes) / double(elements) << '\n';
+	std::cout << "xor_list<int> heap bytes/element: " << double(xorBytes) / double(elements) << '\n';
+
+	bench::run("list push_back", elements, [&]
+		{
+			list<int> built;
+			for (std::size_t i = 0; i < elements; i++)
+				built.push_back(int(i));
+			return built.size();
+		});
+	bench::run("xor_list push_back", elements, [&]
+		{
+			xor_list<int> built;
+			for (std::size_t i = 0; i < elements; i++)
+				built.push_back(int(i));
+			return built.size();
+		});
+
+	list<int> plain;
+	xor_list<int> compact;
+	for (std::size_t i = 0; i < elements; i++)
+	{
+		plain.push_back(int(i));
+		compact.push_back(int(i));
+	}
+
+	bench::run("list accumulate", elements, [&] { return plain.accumulate(0LL); });
+	bench::run("xor_list accumulate", elements, [&] { return compact.accumulate(0LL); });
+	bench::run("list range-for", elements, [&]
+		{
+			long long total = 0;
+			for (int e : plain)
+				total += e;
+			return total;
+		});
+	bench::run("xor_list range-for", elements, [&]
+		{
+			long long total = 0;
+			for (int e : compact)
+				total += e;
+			return total;
+		});
+	bench::run("xor_list reverse walk", elements, [&]
+		{
+			long long total = 0;
+			for (auto it = compact.crbegin(); it != compact.crend(); ++it)
+				total += *it;
+			return total;
+		});
+}
@@ -0,0 +1,711 @@
+#pragma once
+
+#include<algorithm>
+#include<concepts>
+#include<cstddef>
+#include<cstdint>
+#include<initializer_list>
+#include<iterator>
+#include<limits>
+#include<stdexcept>
+#include<utility>
+
+namespace list_monoid
+{
+	template<class M, class T>
+	concept monoid = requires(const M& m, const T& value, const typename M::value_type& summary)
+	{
+		{ m.identity() } -> std::convertible_to<typename M::value_type>;
+		{ m.measure(value) } -> std::convertible_to<typename M::value_type>;
+		{ m.combine(summary, summary) } -> std::convertible_to<typename M::value_type>;
+	};
+
+	template<class T>
+	struct sum
+	{
+		using value_type = T;
+
+		value_type identity() const { return T{}; }
+		value_type measure(const T& value) const { return value; }
+		value_type combine(const value_type& left, const value_type& right) const { return left + right; }
+	};
+
+	template<class T>
+		requires std::numeric_limits<T>::is_specialized
+	struct min
+	{
+		using value_type = T;
+
+		value_type identity() const { return std::numeric_limits<T>::max(); }
+		value_type measure(const T& value) const { return value; }
+		value_type combine(const value_type& left, const value_type& right) const { return std::min(left, right); }
+	};
+
+	template<class T>
+		requires std::numeric_limits<T>::is_specialized
+	struct max
+	{
+		using value_type = T;
+
+		value_type identity() const { return std::numeric_limits<T>::lowest(); }
+		value_type measure(const T& value) const { return value; }
+		value_type combine(const value_type& left, const value_type& right) const { return std::max(left, right); }
+	};
+
+	template<class T>
+		requires std::numeric_limits<T>::is_specialized
+	struct summary
+	{
+		struct value_type
+		{
+			std::size_t count = 0;
+			T sum{};
+			T min = std::numeric_limits<T>::max();
+			T max = std::numeric_limits<T>::lowest();
+
+			bool operator==(const value_type&) const = default;
+		};
+
+		value_type identity() const { return {}; }
+		value_type measure(const T& value) const { return { 1, value, value, value }; }
+
+		value_type combine(const value_type& left, const value_type& right) const
+		{
+			return { left.count + right.count, left.sum + right.sum, std::min(left.min, right.min), std::max(left.max, right.max) };
+		}
+	};
+}
+
+template<class T, class Monoid>
+	requires list_monoid::monoid<Monoid, T>
+class annotated_list
+{
+public:
+	using summary_type = typename Monoid::value_type;
+	static constexpr std::size_t chunk_capacity = 64;
+
+private:
+	struct chunk;
+
+	struct link
+	{
+		link* previous;
+		link* next;
+	};
+
+	struct node : link
+	{
+		chunk* owner;
+		T value;
+
+		template<typename... Args>
+		node(Args&&...args) : link{ nullptr, nullptr }, owner(nullptr), value(std::forward<Args>(args)...) {}
+	};
+
+	struct chunk
+	{
+		node* first;
+		node* last;
+		std::size_t count;
+		summary_type own;
+		summary_type total;
+		std::size_t chunks;
+		chunk* left;
+		chunk* right;
+		chunk* parent;
+		std::uint64_t priority;
+	};
+
+	link head;
+	chunk* root;
+	std::size_t nelms;
+	std::uint64_t seed;
+	[[no_unique_address]] Monoid monoid;
+
+	std::uint64_t nextPriority() noexcept
+	{
+		std::uint64_t z = (seed += 0x9e3779b97f4a7c15ull);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+		return z ^ (z >> 31);
+	}
+
+	static std::size_t chunksIn(const chunk* tree) noexcept
+	{
+		return tree ? tree->chunks : 0;
+	}
+
+	summary_type totalOf(const chunk* tree) const
+	{
+		return tree ? tree->total : monoid.identity();
+	}
+
+	void pull(chunk* tree) const
+	{
+		tree->total = monoid.combine(monoid.combine(totalOf(tree->left), tree->own), totalOf(tree->right));
+		tree->chunks = 1 + chunksIn(tree->left) + chunksIn(tree->right);
+	}
+
+	void refreshUp(chunk* tree) const
+	{
+		for (; tree; tree = tree->parent)
+			pull(tree);
+	}
+
+	chunk* join(chunk* left, chunk* right) const
+	{
+		if (!left)
+			return right;
+		if (!right)
+			return left;
+
+		if (left->priority > right->priority)
+		{
+			left->right = join(left->right, right);
+			left->right->parent = left;
+			pull(left);
+			return left;
+		}
+
+		right->left = join(left, right->left);
+		right->left->parent = right;
+		pull(right);
+		return right;
+	}
+
+	std::pair<chunk*, chunk*> cut(chunk* tree, std::size_t leftChunks) const
+	{
+		if (!tree)
+			return { nullptr, nullptr };
+
+		if (chunksIn(tree->left) >= leftChunks)
+		{
+			auto [left, right] = cut(tree->left, leftChunks);
+			tree->left = right;
+			if (right)
+				right->parent = tree;
+			if (left)
+				left->parent = nullptr;
+			tree->parent = nullptr;
+			pull(tree);
+			return { left, tree };
+		}
+
+		auto [left, right] = cut(tree->right, leftChunks - chunksIn(tree->left) - 1);
+		tree->right = left;
+		if (left)
+			left->parent = tree;
+		if (right)
+			right->parent = nullptr;
+		tree->parent = nullptr;
+		pull(tree);
+		return { tree, right };
+	}
+
+	static std::size_t rankOf(const chunk* target) noexcept
+	{
+		std::size_t rank = chunksIn(target->left);
+		for (; target->parent; target = target->parent)
+			if (target->parent->right == target)
+				rank += chunksIn(target->parent->left) + 1;
+		return rank;
+	}
+
+	summary_type query(const chunk* tree, std::size_t first, std::size_t last) const
+	{
+		if (!tree || first >= last || first >= tree->chunks)
+			return monoid.identity();
+		if (first == 0 && last >= tree->chunks)
+			return tree->total;
+
+		const std::size_t here = chunksIn(tree->left);
+		summary_type result = query(tree->left, first, std::min(last, here));
+		if (first <= here && here < last)
+			result = monoid.combine(result, tree->own);
+		if (last > here + 1)
+			result = monoid.combine(result, query(tree->right, first > here ? first - here - 1 : 0, last - here - 1));
+		return result;
+	}
+
+	summary_type fold(const link* first, const link* last) const
+	{
+		summary_type result = monoid.identity();
+		for (; first != last; first = first->next)
+			result = monoid.combine(result, monoid.measure(static_cast<const node*>(first)->value));
+		return result;
+	}
+
+	void recompute(chunk* target) const
+	{
+		target->own = fold(target->first, target->last->next);
+	}
+
+	chunk* makeChunk(node* first, node* last, std::size_t count)
+	{
+		chunk* created = new chunk{ first, last, count, monoid.identity(), monoid.identity(), 1, nullptr, nullptr, nullptr, nextPriority() };
+		for (link* current = first; current != last->next; current = current->next)
+			static_cast<node*>(current)->owner = created;
+		recompute(created);
+		pull(created);
+		return created;
+	}
+
+	void insertChunkAt(chunk* created, std::size_t rank)
+	{
+		auto [left, right] = cut(root, rank);
+		root = join(join(left, created), right);
+		root->parent = nullptr;
+	}
+
+	void removeChunk(chunk* target)
+	{
+		auto [left, rest] = cut(root, rankOf(target));
+		auto [removed, right] = cut(rest, 1);
+		root = join(left, right);
+		if (root)
+			root->parent = nullptr;
+		delete removed;
+	}
+
+	void splitChunkAt(chunk* target, node* middle)
+	{
+		std::size_t leftCount = 0;
+		for (link* current = target->first; current != middle; current = current->next)
+			++leftCount;
+
+		node* last = target->last;
+		const std::size_t rightCount = target->count - leftCount;
+		target->last = static_cast<node*>(middle->previous);
+		target->count = leftCount;
+		recompute(target);
+		refreshUp(target);
+
+		insertChunkAt(makeChunk(middle, last, rightCount), rankOf(target) + 1);
+	}
+
+	void absorbNext(chunk* target)
+	{
+		if (target->last->next == &head)
+			return;
+		chunk* next = static_cast<node*>(target->last->next)->owner;
+		if (target->count + next->count > chunk_capacity / 2)
+			return;
+
+		for (link* current = next->first; current != next->last->next; current = current->next)
+			static_cast<node*>(current)->owner = target;
+		target->last = next->last;
+		target->count += next->count;
+		recompute(target);
+		refreshUp(target);
+		removeChunk(next);
+	}
+
+	void linkBefore(link* where, link* first, link* last) noexcept
+	{
+		first->previous = where->previous;
+		last->next = where;
+		where->previous->next = first;
+		where->previous = last;
+	}
+
+	void attach(node* created, link* where)
+	{
+		linkBefore(where, created, created);
+		++nelms;
+
+		if (!root)
+		{
+			root = makeChunk(created, created, 1);
+			return;
+		}
+
+		chunk* target;
+		if (where == &head)
+		{
+			target = static_cast<node*>(created->previous)->owner;
+			target->last = created;
+			created->owner = target;
+			target->own = monoid.combine(target->own, monoid.measure(created->value));
+		}
+		else
+		{
+			target = static_cast<node*>(where)->owner;
+			if (target->first == where)
+				target->first = created;
+			created->owner = target;
+			if (target->first == created)
+				target->own = monoid.combine(monoid.measure(created->value), target->own);
+			else
+				recompute(target);
+		}
+
+		++target->count;
+		refreshUp(target);
+		if (target->count > chunk_capacity)
+		{
+			link* middle = target->first;
+			for (std::size_t i = 0; i < target->count / 2; i++)
+				middle = middle->next;
+			splitChunkAt(target, static_cast<node*>(middle));
+		}
+	}
+
+	void detach(node* target)
+	{
+		chunk* owner = target->owner;
+		link* next = target->next;
+		target->previous->next = next;
+		next->previous = target->previous;
+		--nelms;
+
+		if (owner->count == 1)
+		{
+			removeChunk(owner);
+			return;
+		}
+
+		if (owner->first == target)
+			owner->first = static_cast<node*>(next);
+		if (owner->last == target)
+			owner->last = static_cast<node*>(target->previous);
+		--owner->count;
+		recompute(owner);
+		refreshUp(owner);
+
+		if (owner->count < chunk_capacity / 4)
+			absorbNext(owner);
+	}
+
+	void releaseChunks(chunk* tree) noexcept
+	{
+		if (!tree)
+			return;
+		releaseChunks(tree->left);
+		releaseChunks(tree->right);
+		delete tree;
+	}
+
+	void steal(annotated_list& other) noexcept
+	{
+		if (other.head.next != &other.head)
+		{
+			head.next = other.head.next;
+			head.previous = other.head.previous;
+			head.next->previous = &head;
+			head.previous->next = &head;
+		}
+		root = std::exchange(other.root, nullptr);
+		nelms = std::exchange(other.nelms, 0);
+		other.head.next = other.head.previous = &other.head;
+	}
+
+	void deepCopy(const annotated_list& other)
+	{
+		for (const T& e : other)
+			push_back(e);
+	}
+
+	template<bool Reverse>
+	class basic_iterator
+	{
+	private:
+		link* current;
+
+	public:
+		friend class annotated_list;
+		static constexpr bool reversed = Reverse;
+
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const T*;
+		using reference = const T&;
+
+		basic_iterator() : current(nullptr) {}
+		explicit basic_iterator(link* current_) : current(current_) {}
+
+		basic_iterator& operator++()
+		{
+			current = Reverse ? current->previous : current->next;
+			return *this;
+		}
+
+		basic_iterator operator++(int)
+		{
+			auto aux = *this;
+			++(*this);
+			return aux;
+		}
+
+		basic_iterator& operator--()
+		{
+			current = Reverse ? current->next : current->previous;
+			return *this;
+		}
+
+		basic_iterator operator--(int)
+		{
+			auto aux = *this;
+			--(*this);
+			return aux;
+		}
+
+		reference operator*() const
+		{
+			return static_cast<const node*>(current)->value;
+		}
+
+		pointer operator->() const
+		{
+			return &**this;
+		}
+
+		bool operator==(const basic_iterator& it) const noexcept
+		{
+			return current == it.current;
+		}
+	};
+
+public:
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<false>;
+	using reverse_iterator = basic_iterator<true>;
+	using const_reverse_iterator = basic_iterator<true>;
+
+	explicit annotated_list(Monoid monoid_ = {}) : head{ &head, &head }, root(nullptr), nelms(0), seed(0), monoid(std::move(monoid_)) {}
+
+	annotated_list(const std::initializer_list<T>& ilist, Monoid monoid_ = {}) : annotated_list(std::move(monoid_))
+	{
+		for (const T& e : ilist)
+			push_back(e);
+	}
+
+	annotated_list(const annotated_list& other) : annotated_list(other.monoid)
+	{
+		deepCopy(other);
+	}
+
+	annotated_list(annotated_list&& other) noexcept : annotated_list(other.monoid)
+	{
+		steal(other);
+	}
+
+	annotated_list& operator=(const annotated_list& other)
+	{
+		if (this != &other)
+		{
+			clear();
+			monoid = other.monoid;
+			deepCopy(other);
+		}
+		return *this;
+	}
+
+	annotated_list& operator=(annotated_list&& other) noexcept
+	{
+		if (this != &other)
+		{
+			clear();
+			monoid = std::move(other.monoid);
+			steal(other);
+		}
+		return *this;
+	}
+
+	~annotated_list()
+	{
+		clear();
+	}
+
+	bool operator==(const annotated_list& other) const
+	{
+		return size() == other.size() && std::equal(begin(), end(), other.begin());
+	}
+
+	template <typename... Args>
+	iterator emplace(const_iterator it, Args&&...args)
+	{
+		node* created = new node(std::forward<Args>(args)...);
+		attach(created, it.current);
+		return iterator(created);
+	}
+
+	template <typename... Args>
+	void emplace_back(Args&&...args)
+	{
+		attach(new node(std::forward<Args>(args)...), &head);
+	}
+
+	template <typename... Args>
+	void emplace_front(Args&&...args)
+	{
+		attach(new node(std::forward<Args>(args)...), head.next);
+	}
+
+	iterator insert(const_iterator it, const T& newvalue)
+	{
+		return emplace(it, newvalue);
+	}
+
+	iterator insert(const_iterator it, T&& newvalue)
+	{
+		return emplace(it, std::move(newvalue));
+	}
+
+	void push_back(const T& newvalue)
+	{
+		emplace_back(newvalue);
+	}
+
+	void push_back(T&& newvalue)
+	{
+		emplace_back(std::move(newvalue));
+	}
+
+	void push_front(const T& newvalue)
+	{
+		emplace_front(newvalue);
+	}
+
+	void push_front(T&& newvalue)
+	{
+		emplace_front(std::move(newvalue));
+	}
+
+	iterator pop(const_iterator it)
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		if (it.current == &head)
+			throw std::runtime_error("pop called on head");
+		link* next = it.current->next;
+		node* target = static_cast<node*>(it.current);
+		detach(target);
+		delete target;
+		return iterator(next);
+	}
+
+	void pop_back()
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		pop(const_iterator(head.previous));
+	}
+
+	void pop_front()
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		pop(const_iterator(head.next));
+	}
+
+	template<class Function>
+	void update(const_iterator it, Function function)
+	{
+		if (it.current == &head)
+			throw std::runtime_error("update called on head");
+		node* target = static_cast<node*>(it.current);
+		function(target->value);
+		recompute(target->owner);
+		refreshUp(target->owner);
+	}
+
+	void splice(const_iterator where, annotated_list& rightlist)
+	{
+		if (rightlist.empty() || &rightlist == this)
+			return;
+
+		link* before = where.current == &head ? head.next : where.current->next;
+		std::size_t rank = root ? root->chunks : 0;
+		if (before != &head)
+		{
+			node* target = static_cast<node*>(before);
+			if (target->owner->first != target)
+				splitChunkAt(target->owner, target);
+			rank = rankOf(target->owner);
+		}
+
+		linkBefore(before, rightlist.head.next, rightlist.head.previous);
+		auto [left, right] = cut(root, rank);
+		root = join(join(left, rightlist.root), right);
+		root->parent = nullptr;
+		nelms += rightlist.nelms;
+
+		rightlist.root = nullptr;
+		rightlist.nelms = 0;
+		rightlist.head.next = rightlist.head.previous = &rightlist.head;
+	}
+
+	[[nodiscard]] summary_type aggregate() const
+	{
+		return totalOf(root);
+	}
+
+	[[nodiscard]] summary_type aggregate(const_iterator first, const_iterator last) const
+	{
+		if (first == last)
+			return monoid.identity();
+		if (first.current == &head)
+			throw std::invalid_argument("aggregate range starts at head");
+
+		const chunk* from = static_cast<const node*>(first.current)->owner;
+		const chunk* to = last.current == &head ? nullptr : static_cast<const node*>(last.current)->owner;
+		if (from == to)
+			return fold(first.current, last.current);
+
+		const summary_type leading = fold(first.current, from->last->next);
+		const summary_type middle = query(root, rankOf(from) + 1, to ? rankOf(to) : root->chunks);
+		const summary_type trailing = to ? fold(to->first, last.current) : monoid.identity();
+		return monoid.combine(monoid.combine(leading, middle), trailing);
+	}
+
+	[[nodiscard]] std::size_t chunk_count() const noexcept
+	{
+		return chunksIn(root);
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept
+	{
+		return nelms;
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return nelms == 0;
+	}
+
+	const T& front() const
+	{
+		if (empty())
+			throw std::length_error("front called on empty list");
+		return static_cast<const node*>(head.next)->value;
+	}
+
+	const T& back() const
+	{
+		if (empty())
+			throw std::length_error("back called on empty list");
+		return static_cast<const node*>(head.previous)->value;
+	}
+
+	void clear()
+	{
+		for (link* current = head.next; current != &head;)
+		{
+			link* next = current->next;
+			delete static_cast<node*>(current);
+			current = next;
+		}
+		releaseChunks(root);
+		root = nullptr;
+		head.next = head.previous = &head;
+		nelms = 0;
+	}
+
+	[[nodiscard]] const_iterator begin() const noexcept { return const_iterator(head.next); }
+	[[nodiscard]] const_iterator end() const noexcept { return const_iterator(const_cast<link*>(&head)); }
+	[[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+	[[nodiscard]] const_iterator cend() const noexcept { return end(); }
+	[[nodiscard]] const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(head.previous); }
+	[[nodiscard]] const_reverse_iterator rend() const noexcept { return const_reverse_iterator(const_cast<link*>(&head)); }
+};
@@ -0,0 +1,370 @@
+#pragma once
+
+#include<algorithm>
+#include<cerrno>
+#include<cstddef>
+#include<cstring>
+#include<mutex>
+#include<new>
+#include<span>
+#include<stdexcept>
+#include<system_error>
+#include<utility>
+#include<vector>
+#include<sys/uio.h>
+#include<unistd.h>
+#include "list.h"
+
+class buffer_pool
+{
+private:
+	std::size_t blockBytes;
+	std::size_t maxCached;
+	std::vector<std::byte*> cached;
+	std::size_t allocatedBlocks;
+	std::size_t reusedBlocks;
+	mutable std::mutex guard;
+
+	static constexpr std::align_val_t block_alignment{ 64 };
+
+public:
+	static constexpr std::size_t default_block_bytes = std::size_t(16) << 10;
+
+	explicit buffer_pool(std::size_t block_bytes = default_block_bytes, std::size_t max_cached = 256)
+		: blockBytes(block_bytes), maxCached(max_cached), allocatedBlocks(0), reusedBlocks(0)
+	{
+		if (blockBytes == 0)
+			throw std::invalid_argument("buffer_pool block size must be positive");
+	}
+
+	buffer_pool(const buffer_pool&) = delete;
+	buffer_pool& operator=(const buffer_pool&) = delete;
+
+	~buffer_pool()
+	{
+		for (std::byte* block : cached)
+			::operator delete(block, block_alignment);
+	}
+
+	static buffer_pool& shared()
+	{
+		static buffer_pool pool;
+		return pool;
+	}
+
+	[[nodiscard]] std::size_t block_bytes() const noexcept
+	{
+		return blockBytes;
+	}
+
+	[[nodiscard]] std::byte* acquire()
+	{
+		{
+			std::lock_guard lock(guard);
+			if (!cached.empty())
+			{
+				std::byte* block = cached.back();
+				cached.pop_back();
+				++reusedBlocks;
+				return block;
+			}
+			++allocatedBlocks;
+		}
+		return static_cast<std::byte*>(::operator new(blockBytes, block_alignment));
+	}
+
+	void release(std::byte* block) noexcept
+	{
+		{
+			std::lock_guard lock(guard);
+			if (cached.size() < maxCached)
+			{
+				try
+				{
+					cached.push_back(block);
+					return;
+				}
+				catch (...)
+				{
+				}
+			}
+		}
+		::operator delete(block, block_alignment);
+	}
+
+	[[nodiscard]] std::size_t allocated_blocks() const
+	{
+		std::lock_guard lock(guard);
+		return allocatedBlocks;
+	}
+
+	[[nodiscard]] std::size_t reused_blocks() const
+	{
+		std::lock_guard lock(guard);
+		return reusedBlocks;
+	}
+
+	[[nodiscard]] std::size_t cached_blocks() const
+	{
+		std::lock_guard lock(guard);
+		return cached.size();
+	}
+};
+
+class buffer_chain
+{
+public:
+	struct buffer
+	{
+		std::span<std::byte> bytes;
+		std::byte* block = nullptr;
+	};
+
+private:
+	buffer_pool* pool;
+	list<buffer> buffers;
+	std::size_t totalBytes;
+
+	std::size_t tailSpare() const
+	{
+		if (buffers.empty())
+			return 0;
+		const buffer& tail = buffers.back();
+		if (!tail.block)
+			return 0;
+		return static_cast<std::size_t>(tail.block + pool->block_bytes() - (tail.bytes.data() + tail.bytes.size()));
+	}
+
+	void releaseFront()
+	{
+		std::byte* block = buffers.front().block;
+		buffers.pop_front();
+		if (block)
+			pool->release(block);
+	}
+
+	[[noreturn]] static void fail(const char* what)
+	{
+		throw std::system_error(errno, std::generic_category(), what);
+	}
+
+public:
+	explicit buffer_chain(buffer_pool& pool_ = buffer_pool::shared()) : pool(&pool_), totalBytes(0) {}
+
+	buffer_chain(const buffer_chain&) = delete;
+	buffer_chain& operator=(const buffer_chain&) = delete;
+
+	buffer_chain(buffer_chain&& other) noexcept
+		: pool(other.pool), buffers(std::move(other.buffers)), totalBytes(std::exchange(other.totalBytes, 0)) {}
+
+	~buffer_chain()
+	{
+		clear();
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept
+	{
+		return totalBytes;
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return totalBytes == 0;
+	}
+
+	[[nodiscard]] std::size_t buffer_count() const noexcept
+	{
+		return buffers.size();
+	}
+
+	[[nodiscard]] const list<buffer>& chain() const noexcept
+	{
+		return buffers;
+	}
+
+	void append(std::span<std::byte> bytes)
+	{
+		if (bytes.empty())
+			return;
+		buffers.push_back(buffer{ bytes, nullptr });
+		totalBytes += bytes.size();
+	}
+
+	void append_copy(std::span<const std::byte> bytes)
+	{
+		while (!bytes.empty())
+		{
+			const std::span<std::byte> target = prepare(bytes.size());
+			const std::size_t n = std::min(target.size(), bytes.size());
+			std::memcpy(target.data(), bytes.data(), n);
+			commit(n);
+			bytes = bytes.subspan(n);
+		}
+	}
+
+	[[nodiscard]] std::span<std::byte> prepare(std::size_t wanted)
+	{
+		std::size_t spare = tailSpare();
+		if (spare == 0)
+		{
+			std::byte* block = pool->acquire();
+			try
+			{
+				buffers.push_back(buffer{ std::span<std::byte>(block, 0), block });
+			}
+			catch (...)
+			{
+				pool->release(block);
+				throw;
+			}
+			spare = pool->block_bytes();
+		}
+
+		const buffer& tail = buffers.back();
+		return { tail.bytes.data() + tail.bytes.size(), std::min(wanted, spare) };
+	}
+
+	void commit(std::size_t n)
+	{
+		if (n > tailSpare())
+			throw std::length_error("commit past prepared buffer");
+		buffer& tail = buffers.back();
+		tail.bytes = std::span<std::byte>(tail.bytes.data(), tail.bytes.size() + n);
+		totalBytes += n;
+	}
+
+	void consume(std::size_t n)
+	{
+		if (n > totalBytes)
+			throw std::length_error("consume past end of buffer chain");
+
+		totalBytes -= n;
+		while (n > 0)
+		{
+			buffer& front = buffers.front();
+			if (n < front.bytes.size())
+			{
+				front.bytes = front.bytes.subspan(n);
+				return;
+			}
+			n -= front.bytes.size();
+			releaseFront();
+		}
+	}
+
+	std::size_t as_iovecs(iovec* out, std::size_t max) const
+	{
+		std::size_t filled = 0;
+		for (const buffer& current : buffers)
+		{
+			if (filled == max)
+				break;
+			if (!current.bytes.empty())
+			{
+				out[filled].iov_base = current.bytes.data();
+				out[filled].iov_len = current.bytes.size();
+				++filled;
+			}
+		}
+		return filled;
+	}
+
+	std::size_t as_iovecs(std::span<iovec> out) const
+	{
+		return as_iovecs(out.data(), out.size());
+	}
+
+	std::size_t write_to(int fd, std::size_t max_iovecs = 64)
+	{
+		std::vector<iovec> vectors(std::max<std::size_t>(max_iovecs, 1));
+		const std::size_t count = as_iovecs(vectors.data(), vectors.size());
+		if (count == 0)
+			return 0;
+
+		ssize_t written;
+		do
+			written = ::writev(fd, vectors.data(), static_cast<int>(count));
+		while (written < 0 && errno == EINTR);
+		if (written < 0)
+		{
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+				return 0;
+			fail("writev");
+		}
+
+		consume(static_cast<std::size_t>(written));
+		return static_cast<std::size_t>(written);
+	}
+
+	std::size_t read_from(int fd, std::size_t max_bytes)
+	{
+		std::vector<iovec> vectors;
+		std::vector<std::byte*> fresh;
+		std::size_t offered = 0;
+
+		const std::size_t spare = std::min(tailSpare(), max_bytes);
+		if (spare > 0)
+		{
+			const buffer& tail = buffers.back();
+			vectors.push_back({ tail.bytes.data() + tail.bytes.size(), spare });
+			offered = spare;
+		}
+
+		try
+		{
+			while (offered < max_bytes)
+			{
+				std::byte* block = pool->acquire();
+				fresh.push_back(block);
+				const std::size_t n = std::min(pool->block_bytes(), max_bytes - offered);
+				vectors.push_back({ block, n });
+				offered += n;
+			}
+		}
+		catch (...)
+		{
+			for (std::byte* block : fresh)
+				pool->release(block);
+			throw;
+		}
+
+		ssize_t got;
+		do
+			got = ::readv(fd, vectors.data(), static_cast<int>(vectors.size()));
+		while (got < 0 && errno == EINTR);
+		const int error = errno;
+
+		std::size_t remaining = got > 0 ? static_cast<std::size_t>(got) : 0;
+		const std::size_t total = remaining;
+		std::size_t used = 0;
+		if (spare > 0)
+		{
+			const std::size_t n = std::min(remaining, spare);
+			commit(n);
+			remaining -= n;
+		}
+		for (; used < fresh.size() && remaining > 0; used++)
+		{
+			const std::size_t n = std::min(remaining, pool->block_bytes());
+			buffers.push_back(buffer{ std::span<std::byte>(fresh[used], n), fresh[used] });
+			totalBytes += n;
+			remaining -= n;
+		}
+		for (; used < fresh.size(); used++)
+			pool->release(fresh[used]);
+
+		if (got < 0 && error != EAGAIN && error != EWOULDBLOCK)
+		{
+			errno = error;
+			fail("readv");
+		}
+		return total;
+	}
+
+	void clear()
+	{
+		while (!buffers.empty())
+			releaseFront();
+		totalBytes = 0;
+	}
+};
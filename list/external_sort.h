@@ -0,0 +1,305 @@
+#pragma once
+
+#include<algorithm>
+#include<atomic>
+#include<cstddef>
+#include<cstdint>
+#include<exception>
+#include<filesystem>
+#include<fstream>
+#include<functional>
+#include<memory>
+#include<optional>
+#include<random>
+#include<stdexcept>
+#include<string>
+#include<system_error>
+#include<utility>
+#include<vector>
+#include "list.h"
+#include "serialization.h"
+
+struct external_sort_options
+{
+	std::size_t fan_in = 16;
+	std::size_t io_buffer_bytes = list_io::buffer_bytes;
+};
+
+namespace external_sort_detail
+{
+	struct value_footprint
+	{
+		template<typename T>
+		std::size_t operator()(const T& value) const noexcept
+		{
+			return static_cast<std::size_t>(list_stats::value_bytes(value));
+		}
+	};
+
+	class run_file
+	{
+	private:
+		std::filesystem::path path;
+
+		static std::filesystem::path uniquePath(const std::filesystem::path& directory)
+		{
+			static std::atomic<std::uint64_t> counter{ 0 };
+			static const std::uint64_t stamp = (std::uint64_t(std::random_device{}()) << 32) | std::random_device{}();
+			for (;;)
+			{
+				std::filesystem::path candidate = directory / ("list_external_sort_" + std::to_string(stamp) + "_" + std::to_string(counter++) + ".run");
+				if (!std::filesystem::exists(candidate))
+					return candidate;
+			}
+		}
+
+	public:
+		explicit run_file(const std::filesystem::path& directory) : path(uniquePath(directory)) {}
+
+		run_file(const run_file&) = delete;
+		run_file& operator=(const run_file&) = delete;
+
+		run_file(run_file&& other) noexcept : path(std::exchange(other.path, {})) {}
+
+		run_file& operator=(run_file&& other) noexcept
+		{
+			if (this != &other)
+			{
+				discard();
+				path = std::exchange(other.path, {});
+			}
+			return *this;
+		}
+
+		~run_file()
+		{
+			discard();
+		}
+
+		void discard() noexcept
+		{
+			if (!path.empty())
+			{
+				std::error_code ignored;
+				std::filesystem::remove(path, ignored);
+				path.clear();
+			}
+		}
+
+		std::filesystem::path release() noexcept
+		{
+			return std::exchange(path, {});
+		}
+
+		const std::filesystem::path& location() const noexcept
+		{
+			return path;
+		}
+	};
+
+	class run_output
+	{
+	private:
+		std::ofstream file;
+
+	public:
+		list_io::writer out;
+
+		run_output(const run_file& run, std::size_t bufferBytes)
+			: file(run.location(), std::ios::binary | std::ios::trunc), out(file, bufferBytes)
+		{
+			if (!file)
+				throw std::runtime_error("external_sort could not create run file " + run.location().string());
+		}
+	};
+
+	template<typename T>
+	class run_input
+	{
+	private:
+		std::ifstream file;
+		list_io::reader in;
+		list_io::codec<T> decoder;
+		std::uint64_t remaining;
+
+	public:
+		std::optional<T> current;
+
+		run_input(const run_file& run, std::size_t bufferBytes)
+			: file(run.location(), std::ios::binary), in(file, bufferBytes), remaining(0)
+		{
+			if (!file)
+				throw std::runtime_error("external_sort could not open run file " + run.location().string());
+			remaining = list_io::read_header<T>(in);
+			advance();
+		}
+
+		void advance()
+		{
+			if (remaining == 0)
+			{
+				current.reset();
+				return;
+			}
+			current.emplace(decoder.decode(in));
+			--remaining;
+		}
+
+		std::uint64_t size() const noexcept
+		{
+			return remaining + (current ? 1 : 0);
+		}
+	};
+
+	template<typename T>
+	std::string restoreRuns(list<T>& target, std::vector<run_file>& runs, std::size_t bufferBytes)
+	{
+		std::string kept;
+		for (run_file& run : runs)
+		{
+			if (run.location().empty())
+				continue;
+			try
+			{
+				std::ifstream file(run.location(), std::ios::binary);
+				if (!file)
+					throw std::runtime_error("external_sort could not open run file " + run.location().string());
+				list_io::reader in(file, bufferBytes);
+				list<T> loaded;
+				list_io::load(loaded, in);
+				target.splice(target.end(), loaded);
+				run.discard();
+			}
+			catch (...)
+			{
+				kept += " " + run.release().string();
+			}
+		}
+		return kept;
+	}
+
+	template<typename T, class Compare, class Sink>
+	void mergeRuns(std::vector<run_file>& runs, std::size_t first, std::size_t last, Compare& compare, std::size_t bufferBytes, Sink sink)
+	{
+		std::vector<std::unique_ptr<run_input<T>>> inputs;
+		std::uint64_t total = 0;
+		for (std::size_t i = first; i < last; i++)
+		{
+			inputs.push_back(std::make_unique<run_input<T>>(runs[i], bufferBytes));
+			total += inputs.back()->size();
+		}
+
+		auto later = [&](std::size_t a, std::size_t b)
+			{
+				const T& left = *inputs[a]->current;
+				const T& right = *inputs[b]->current;
+				if (compare(right, left))
+					return true;
+				if (compare(left, right))
+					return false;
+				return a > b;
+			};
+
+		std::vector<std::size_t> heap;
+		for (std::size_t i = 0; i < inputs.size(); i++)
+			if (inputs[i]->current)
+				heap.push_back(i);
+		std::make_heap(heap.begin(), heap.end(), later);
+
+		sink(total, [&]
+			{
+				std::pop_heap(heap.begin(), heap.end(), later);
+				run_input<T>& source = *inputs[heap.back()];
+				T value = std::move(*source.current);
+				source.advance();
+				if (source.current)
+					std::push_heap(heap.begin(), heap.end(), later);
+				else
+					heap.pop_back();
+				return value;
+			});
+	}
+}
+
+template<class T, class Compare = std::less<>, class Footprint = external_sort_detail::value_footprint>
+void external_sort(list<T>& target, std::size_t memory_budget, const std::filesystem::path& tmpdir,
+	external_sort_options options = {}, Compare compare = {}, Footprint footprint = {})
+{
+	using namespace external_sort_detail;
+
+	if (options.fan_in < 2)
+		throw std::invalid_argument("external_sort fan_in must be at least 2");
+	if (memory_budget < list<T>::node_bytes)
+		throw std::invalid_argument("external_sort memory budget is too small");
+
+	std::vector<run_file> runs;
+	std::vector<run_file> merged;
+	list<T> piece;
+	bool draining = false;
+	try
+	{
+		while (!target.empty())
+		{
+			std::size_t used = 0;
+			while (!target.empty())
+			{
+				const std::size_t bytes = list<T>::node_bytes - sizeof(T) + std::size_t(footprint(std::as_const(target).front()));
+				if (!piece.empty() && bytes > memory_budget - used)
+					break;
+				used += std::min(bytes, memory_budget - used);
+				piece.insert(piece.end(), target.extract(target.begin()));
+			}
+			piece.merge_sort(compare);
+			if (runs.empty() && target.empty())
+			{
+				target.splice(target.end(), piece);
+				return;
+			}
+
+			run_file run(tmpdir);
+			run_output output(run, options.io_buffer_bytes);
+			list_io::save(piece, output.out);
+			runs.push_back(std::move(run));
+			piece.clear();
+		}
+
+		while (runs.size() > options.fan_in)
+		{
+			for (std::size_t first = 0; first < runs.size(); first += options.fan_in)
+			{
+				const std::size_t last = std::min(first + options.fan_in, runs.size());
+				run_file run(tmpdir);
+				run_output output(run, options.io_buffer_bytes);
+				list_io::codec<T> encoder;
+				mergeRuns<T>(runs, first, last, compare, options.io_buffer_bytes, [&](std::uint64_t total, auto next)
+					{
+						list_io::write_header<T>(output.out, total);
+						for (std::uint64_t i = 0; i < total; i++)
+							encoder.encode(output.out, next());
+						output.out.flush();
+					});
+				merged.push_back(std::move(run));
+				for (std::size_t i = first; i < last; i++)
+					runs[i].discard();
+			}
+			runs = std::move(merged);
+			merged.clear();
+		}
+
+		draining = true;
+		mergeRuns<T>(runs, 0, runs.size(), compare, options.io_buffer_bytes, [&](std::uint64_t total, auto next)
+			{
+				target.append_n(static_cast<std::size_t>(total), next);
+			});
+	}
+	catch (...)
+	{
+		if (draining)
+			target.clear();
+		target.splice(target.end(), piece);
+		const std::string kept = restoreRuns(target, runs, options.io_buffer_bytes) + restoreRuns(target, merged, options.io_buffer_bytes);
+		if (!kept.empty())
+			std::throw_with_nested(std::runtime_error("external_sort failed; unsorted data left in" + kept));
+		throw;
+	}
+}
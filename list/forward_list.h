@@ -0,0 +1,489 @@
+#pragma once
+
+#include<cstddef>
+#include<functional>
+#include<initializer_list>
+#include<iterator>
+#include<stdexcept>
+#include<type_traits>
+#include<utility>
+#include "list.h"
+
+template<class T>
+class forward_list
+{
+private:
+	struct link
+	{
+		link* next;
+		link() : next(nullptr) {}
+		explicit link(link* nxt) : next(nxt) {}
+	};
+
+	struct node : public link
+	{
+		T value;
+
+		template<typename... Args>
+		node(link* nxt, Args&&...args)
+			: link(nxt), value(std::forward<Args>(args)...) {}
+	};
+
+	link head;
+	link* tail;
+	std::size_t nelms;
+
+	void deepCopy(const forward_list& other)
+	{
+		for (const link* aux = other.head.next; aux; aux = aux->next)
+			push_back(static_cast<const node*>(aux)->value);
+	}
+
+	template<typename ...Args>
+	link* emplaceAfter(link* where, Args&& ...args)
+	{
+		link* newnode = new node(where->next, std::forward<Args>(args)...);
+		where->next = newnode;
+		if (tail == where)
+			tail = newnode;
+		++nelms;
+		return newnode;
+	}
+
+	link* eraseAfter(link* where)
+	{
+		link* target = where->next;
+		if (!target)
+			throw std::runtime_error("erase_after called on last element");
+		where->next = target->next;
+		if (tail == target)
+			tail = where;
+		delete static_cast<node*>(target);
+		--nelms;
+		return where->next;
+	}
+
+	template<class Compare>
+	static link* mergeChains(link* left, link* right, Compare& compare)
+	{
+		link merged;
+		link* last = &merged;
+
+		while (left && right)
+		{
+			if (compare(static_cast<node*>(right)->value, static_cast<node*>(left)->value))
+			{
+				last->next = right;
+				right = right->next;
+			}
+			else
+			{
+				last->next = left;
+				left = left->next;
+			}
+			last = last->next;
+		}
+
+		last->next = left ? left : right;
+		return merged.next;
+	}
+
+	template<bool Const>
+	class basic_iterator
+	{
+	private:
+		link* linker;
+
+	public:
+		friend class forward_list;
+		template<bool> friend class basic_iterator;
+
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, const T*, T*>;
+		using reference = std::conditional_t<Const, const T&, T&>;
+
+		basic_iterator() : linker(nullptr) {}
+		basic_iterator(const link* linker_) : linker(const_cast<link*>(linker_)) {}
+
+		template<bool OtherConst>
+			requires (Const || !OtherConst)
+		basic_iterator(const basic_iterator<OtherConst>& it) : linker(it.linker) {}
+
+		basic_iterator& operator++()
+		{
+			linker = linker->next;
+			return *this;
+		}
+
+		basic_iterator operator++(int)
+		{
+			auto aux = *this;
+			linker = linker->next;
+			return aux;
+		}
+
+		reference operator*() const
+		{
+			if (!linker)
+				throw std::runtime_error("Invalid ptr to use '*' ");
+			return static_cast<node*>(linker)->value;
+		}
+
+		pointer operator->() const
+		{
+			return &**this;
+		}
+
+		template<bool OtherConst>
+		bool operator==(const basic_iterator<OtherConst>& it) const noexcept
+		{
+			return linker == it.linker;
+		}
+	};
+
+public:
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
+	forward_list() : tail(&head), nelms(0) {}
+
+	forward_list(const std::initializer_list<T>& ilist) : forward_list()
+	{
+		for (const T& e : ilist)
+			push_back(e);
+	}
+
+	forward_list(const forward_list& other) : forward_list()
+	{
+		deepCopy(other);
+	}
+
+	forward_list(forward_list&& other) noexcept : forward_list()
+	{
+		splice_after(before_begin(), other);
+	}
+
+	forward_list& operator=(const forward_list& other)
+	{
+		if (this != &other)
+		{
+			clear();
+			deepCopy(other);
+		}
+		return *this;
+	}
+
+	forward_list& operator=(forward_list&& other) noexcept
+	{
+		if (this != &other)
+		{
+			clear();
+			splice_after(before_begin(), other);
+		}
+		return *this;
+	}
+
+	~forward_list()
+	{
+		clear();
+	}
+
+	bool operator==(const forward_list& other) const noexcept
+	{
+		if (size() != other.size())
+			return false;
+
+		for (const link *a = head.next, *b = other.head.next; a; a = a->next, b = b->next)
+			if (static_cast<const node*>(a)->value != static_cast<const node*>(b)->value)
+				return false;
+
+		return true;
+	}
+
+	template <typename... Args>
+	void emplace_back(Args &&...args)
+	{
+		emplaceAfter(tail, std::forward<Args>(args)...);
+	}
+
+	void push_back(const T& newvalue)
+	{
+		emplace_back(newvalue);
+	}
+
+	void push_back(T&& newvalue)
+	{
+		emplace_back(std::move(newvalue));
+	}
+
+	template <typename... Args>
+	void emplace_front(Args &&...args)
+	{
+		emplaceAfter(&head, std::forward<Args>(args)...);
+	}
+
+	void push_front(const T& newvalue)
+	{
+		emplace_front(newvalue);
+	}
+
+	void push_front(T&& newvalue)
+	{
+		emplace_front(std::move(newvalue));
+	}
+
+	void pop_front()
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		eraseAfter(&head);
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept
+	{
+		return nelms;
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return nelms == 0;
+	}
+
+	T& front()
+	{
+		if (empty())
+			throw std::length_error("front called on empty list");
+		return static_cast<node*>(head.next)->value;
+	}
+
+	T& back()
+	{
+		if (empty())
+			throw std::length_error("back called on empty list");
+		return static_cast<node*>(tail)->value;
+	}
+
+	const T& front() const
+	{
+		if (empty())
+			throw std::length_error("front called on empty list");
+		return static_cast<const node*>(head.next)->value;
+	}
+
+	const T& back() const
+	{
+		if (empty())
+			throw std::length_error("back called on empty list");
+		return static_cast<const node*>(tail)->value;
+	}
+
+	void clear()
+	{
+		link* aux = head.next;
+		while (aux)
+		{
+			node* target = static_cast<node*>(aux);
+			aux = aux->next;
+			delete target;
+		}
+
+		head.next = nullptr;
+		tail = &head;
+		nelms = 0;
+	}
+
+	[[nodiscard]] iterator before_begin() noexcept { return &head; }
+	[[nodiscard]] iterator begin() noexcept { return head.next; }
+	[[nodiscard]] iterator end() noexcept { return nullptr; }
+	[[nodiscard]] const_iterator before_begin() const noexcept { return &head; }
+	[[nodiscard]] const_iterator begin() const noexcept { return head.next; }
+	[[nodiscard]] const_iterator end() const noexcept { return nullptr; }
+	[[nodiscard]] const_iterator cbefore_begin() const noexcept { return &head; }
+	[[nodiscard]] const_iterator cbegin() const noexcept { return head.next; }
+	[[nodiscard]] const_iterator cend() const noexcept { return nullptr; }
+
+	template<typename It, typename ...Args>
+		requires std::same_as<It, iterator> || std::same_as<It, const_iterator>
+	It emplace_after(It it, Args&& ... args)
+	{
+		if (!it.linker)
+			throw std::runtime_error("emplace_after called on end");
+		return emplaceAfter(it.linker, std::forward<Args>(args)...);
+	}
+
+	template<typename It>
+		requires std::same_as<It, iterator> || std::same_as<It, const_iterator>
+	It insert_after(It it, const T& newvalue)
+	{
+		return emplace_after<It>(it, newvalue);
+	}
+
+	template<typename It>
+		requires std::same_as<It, iterator> || std::same_as<It, const_iterator>
+	It insert_after(It it, T&& newvalue)
+	{
+		return emplace_after<It>(it, std::move(newvalue));
+	}
+
+	template<typename It>
+		requires std::same_as<It, iterator> || std::same_as<It, const_iterator>
+	It erase_after(It it)
+	{
+		if (empty())
+			throw std::length_error("erase_after called on empty list");
+		if (!it.linker)
+			throw std::runtime_error("erase_after called on end");
+		return eraseAfter(it.linker);
+	}
+
+	template<typename It>
+		requires std::same_as<It, iterator> || std::same_as<It, const_iterator>
+	It erase_after(It first, It last)
+	{
+		if (!first.linker)
+			throw std::runtime_error("erase_after called on end");
+		while (first.linker->next != last.linker)
+			eraseAfter(first.linker);
+		return last;
+	}
+
+	template<typename It>
+		requires std::same_as<It, iterator> || std::same_as<It, const_iterator>
+	void splice_after(It where, forward_list& rightlist)
+	{
+		if (rightlist.empty() || &rightlist == this)
+			return;
+		if (!where.linker)
+			throw std::runtime_error("splice_after called on end");
+
+		link* after = where.linker->next;
+		where.linker->next = rightlist.head.next;
+		rightlist.tail->next = after;
+		if (tail == where.linker)
+			tail = rightlist.tail;
+
+		nelms += rightlist.nelms;
+		rightlist.head.next = nullptr;
+		rightlist.tail = &rightlist.head;
+		rightlist.nelms = 0;
+	}
+
+	template<class Condition>
+	std::size_t remove_if(Condition condition)
+	{
+		const std::size_t before = nelms;
+		link* previous = &head;
+		while (previous->next)
+		{
+			if (condition(std::as_const(static_cast<node*>(previous->next)->value)))
+				eraseAfter(previous);
+			else
+				previous = previous->next;
+		}
+		return before - nelms;
+	}
+
+	template<class Compare = std::less<>>
+	void sort(Compare compare = {})
+	{
+		if (nelms < 2)
+			return;
+
+		link* bins[64] = {};
+		std::size_t usedBins = 0;
+
+		for (link* aux = head.next; aux;)
+		{
+			link* carry = aux;
+			aux = aux->next;
+			carry->next = nullptr;
+
+			std::size_t i = 0;
+			for (; i < usedBins && bins[i]; i++)
+			{
+				carry = mergeChains(bins[i], carry, compare);
+				bins[i] = nullptr;
+			}
+
+			bins[i] = carry;
+			if (i == usedBins)
+				++usedBins;
+		}
+
+		link* result = nullptr;
+		for (std::size_t i = 0; i < usedBins; i++)
+			if (bins[i])
+				result = result ? mergeChains(bins[i], result, compare) : bins[i];
+
+		head.next = result;
+		tail = &head;
+		while (tail->next)
+			tail = tail->next;
+	}
+
+	template<class Function>
+	Function for_each(Function function)
+	{
+		for (link* current = head.next; current; current = current->next)
+		{
+			if (current->next)
+				LIST_PREFETCH(current->next->next);
+			function(static_cast<node*>(current)->value);
+		}
+		return function;
+	}
+
+	template<class Function>
+	Function for_each(Function function) const
+	{
+		const_cast<forward_list*>(this)->for_each([&](T& value) { function(std::as_const(value)); });
+		return function;
+	}
+
+	template<class Condition>
+	[[nodiscard]] iterator find_if(Condition condition)
+	{
+		link* current = head.next;
+		while (current && !condition(std::as_const(static_cast<node*>(current)->value)))
+			current = current->next;
+		return current;
+	}
+
+	template<class Condition>
+	[[nodiscard]] const_iterator find_if(Condition condition) const
+	{
+		return const_cast<forward_list*>(this)->find_if(condition);
+	}
+
+	[[nodiscard]] iterator find(const T& target)
+	{
+		return find_if([&](const T& value) { return value == target; });
+	}
+
+	[[nodiscard]] const_iterator find(const T& target) const
+	{
+		return find_if([&](const T& value) { return value == target; });
+	}
+
+	[[nodiscard]] bool contains(const T& target) const
+	{
+		return find(target) != cend();
+	}
+
+	template<class Condition>
+	[[nodiscard]] std::size_t count_if(Condition condition) const
+	{
+		std::size_t total = 0;
+		for_each([&](const T& value) { total += bool(condition(value)); });
+		return total;
+	}
+
+	template<typename U, class BinaryOperation = std::plus<>>
+	[[nodiscard]] U accumulate(U init, BinaryOperation operation = {}) const
+	{
+		for_each([&](const T& value) { init = operation(std::move(init), value); });
+		return init;
+	}
+};
@@ -0,0 +1,693 @@
+#pragma once
+
+#include<algorithm>
+#include<compare>
+#include<cstddef>
+#include<cstdint>
+#include<cstring>
+#include<functional>
+#include<initializer_list>
+#include<limits>
+#include<new>
+#include<stdexcept>
+#include<type_traits>
+#include<utility>
+#include<vector>
+#include "list.h"
+
+template<class T>
+class index_list
+{
+private:
+	using index_type = std::uint32_t;
+	static constexpr index_type npos = std::numeric_limits<index_type>::max();
+	static constexpr index_type sentinel = 0;
+
+	struct slot
+	{
+		index_type previous;
+		index_type next;
+		alignas(T) std::byte storage[sizeof(T)];
+
+		T& value() noexcept { return *std::launder(reinterpret_cast<T*>(storage)); }
+		const T& value() const noexcept { return *std::launder(reinterpret_cast<const T*>(storage)); }
+	};
+
+	slot* slots = nullptr;
+	index_type slotCapacity = 0;
+	index_type used = 0;
+	index_type freeHead = npos;
+	std::size_t nelms = 0;
+
+	static slot* allocateSlots(index_type count)
+	{
+		return static_cast<slot*>(::operator new(std::size_t(count) * sizeof(slot), std::align_val_t(alignof(slot))));
+	}
+
+	static void deallocateSlots(slot* target) noexcept
+	{
+		::operator delete(target, std::align_val_t(alignof(slot)));
+	}
+
+	void relocate(index_type newCapacity)
+	{
+		slot* newslots = allocateSlots(newCapacity);
+
+		if (!slots)
+		{
+			newslots[sentinel].previous = sentinel;
+			newslots[sentinel].next = sentinel;
+			used = 1;
+		}
+		else if constexpr (std::is_trivially_copyable_v<T>)
+			std::memcpy(static_cast<void*>(newslots), slots, std::size_t(used) * sizeof(slot));
+		else
+		{
+			for (index_type i = 0; i < used; i++)
+			{
+				newslots[i].previous = slots[i].previous;
+				newslots[i].next = slots[i].next;
+			}
+
+			index_type constructed = slots[sentinel].next;
+			try
+			{
+				for (; constructed != sentinel; constructed = slots[constructed].next)
+					new (newslots[constructed].storage) T(std::move_if_noexcept(slots[constructed].value()));
+			}
+			catch (...)
+			{
+				for (index_type i = slots[sentinel].next; i != constructed; i = slots[i].next)
+					newslots[i].value().~T();
+				deallocateSlots(newslots);
+				throw;
+			}
+
+			for (index_type i = slots[sentinel].next; i != sentinel; i = slots[i].next)
+				slots[i].value().~T();
+		}
+
+		deallocateSlots(slots);
+		slots = newslots;
+		slotCapacity = newCapacity;
+	}
+
+	index_type acquireSentinel()
+	{
+		if (!slots)
+			relocate(8);
+		return sentinel;
+	}
+
+	index_type acquireSlot()
+	{
+		if (freeHead != npos)
+		{
+			const index_type target = freeHead;
+			freeHead = slots[target].next;
+			return target;
+		}
+
+		if (used == slotCapacity)
+		{
+			if (slotCapacity == npos)
+				throw std::length_error("index_list capacity exceeded");
+			const std::uint64_t grown = std::max<std::uint64_t>(8, std::uint64_t(slotCapacity) * 2);
+			relocate(index_type(std::min<std::uint64_t>(grown, npos)));
+		}
+
+		return used++;
+	}
+
+	void releaseSlot(index_type target) noexcept
+	{
+		slots[target].value().~T();
+		slots[target].next = freeHead;
+		freeHead = target;
+	}
+
+	void linkBefore(index_type where, index_type target) noexcept
+	{
+		const index_type before = slots[where].previous;
+		slots[target].previous = before;
+		slots[target].next = where;
+		slots[before].next = target;
+		slots[where].previous = target;
+	}
+
+	void unlink(index_type target) noexcept
+	{
+		slots[slots[target].previous].next = slots[target].next;
+		slots[slots[target].next].previous = slots[target].previous;
+	}
+
+	template<typename ...Args>
+	index_type emplaceBefore(index_type where, Args&& ...args)
+	{
+		if (freeHead == npos && used == slotCapacity)
+		{
+			T value(std::forward<Args>(args)...);
+			return constructBefore(where, std::move(value));
+		}
+		return constructBefore(where, std::forward<Args>(args)...);
+	}
+
+	template<typename ...Args>
+	index_type constructBefore(index_type where, Args&& ...args)
+	{
+		const index_type target = acquireSlot();
+		try
+		{
+			new (slots[target].storage) T(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			slots[target].next = freeHead;
+			freeHead = target;
+			throw;
+		}
+		linkBefore(where, target);
+		++nelms;
+		return target;
+	}
+
+	void erase(index_type target) noexcept
+	{
+		unlink(target);
+		releaseSlot(target);
+		--nelms;
+	}
+
+	index_type headNext() const noexcept
+	{
+		return slots ? slots[sentinel].next : sentinel;
+	}
+
+	index_type headPrevious() const noexcept
+	{
+		return slots ? slots[sentinel].previous : sentinel;
+	}
+
+	template<bool Const, bool Reverse>
+	class basic_iterator
+	{
+	private:
+		using owner_type = std::conditional_t<Const, const index_list, index_list>;
+
+		owner_type* owner;
+		index_type position;
+
+	public:
+		friend class index_list;
+		template<bool, bool> friend class basic_iterator;
+
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, const T*, T*>;
+		using reference = std::conditional_t<Const, const T&, T&>;
+
+		basic_iterator() : owner(nullptr), position(sentinel) {}
+		basic_iterator(owner_type* owner_, index_type position_) : owner(owner_), position(position_) {}
+
+		template<bool OtherConst, bool OtherReverse>
+			requires (Const || !OtherConst)
+		basic_iterator(const basic_iterator<OtherConst, OtherReverse>& it) : owner(it.owner), position(it.position) {}
+
+		basic_iterator& operator++()
+		{
+			position = Reverse ? owner->slots[position].previous : owner->slots[position].next;
+			return *this;
+		}
+
+		basic_iterator operator++(int)
+		{
+			auto aux = *this;
+			++(*this);
+			return aux;
+		}
+
+		basic_iterator& operator--()
+		{
+			position = Reverse ? owner->slots[position].next : owner->slots[position].previous;
+			return *this;
+		}
+
+		basic_iterator operator--(int)
+		{
+			auto aux = *this;
+			--(*this);
+			return aux;
+		}
+
+		reference operator*() const
+		{
+			if (position == sentinel)
+				throw std::runtime_error("Invalid ptr to use '*' ");
+			return owner->slots[position].value();
+		}
+
+		pointer operator->() const
+		{
+			return &**this;
+		}
+
+		template<bool OtherConst, bool OtherReverse>
+		bool operator==(const basic_iterator<OtherConst, OtherReverse>& it) const noexcept
+		{
+			return position == it.position;
+		}
+	};
+
+public:
+	using iterator = basic_iterator<false, false>;
+	using const_iterator = basic_iterator<true, false>;
+	using reverse_iterator = basic_iterator<false, true>;
+	using const_reverse_iterator = basic_iterator<true, true>;
+
+	index_list() = default;
+
+	index_list(const std::initializer_list<T>& ilist) : index_list()
+	{
+		reserve(ilist.size());
+		for (const T& e : ilist)
+			push_back(e);
+	}
+
+	template<class NoReverseIT>
+		requires std::same_as<NoReverseIT, iterator> || std::same_as<NoReverseIT, const_iterator>
+	index_list(NoReverseIT begin, NoReverseIT end) : index_list()
+	{
+		while (begin != end)
+		{
+			push_back(*begin);
+			++begin;
+		}
+	}
+
+	index_list(const index_list& other) : index_list()
+	{
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			if (!other.slots)
+				return;
+			slots = allocateSlots(other.slotCapacity);
+			std::memcpy(static_cast<void*>(slots), other.slots, std::size_t(other.used) * sizeof(slot));
+			slotCapacity = other.slotCapacity;
+			used = other.used;
+			freeHead = other.freeHead;
+			nelms = other.nelms;
+		}
+		else
+		{
+			reserve(other.size());
+			for (const T& e : other)
+				push_back(e);
+		}
+	}
+
+	index_list(index_list&& other) noexcept
+		: slots(std::exchange(other.slots, nullptr)),
+		slotCapacity(std::exchange(other.slotCapacity, 0)),
+		used(std::exchange(other.used, 0)),
+		freeHead(std::exchange(other.freeHead, npos)),
+		nelms(std::exchange(other.nelms, 0)) {}
+
+	index_list& operator=(const index_list& other)
+	{
+		if (this != &other)
+		{
+			index_list copy(other);
+			swap(copy);
+		}
+		return *this;
+	}
+
+	index_list& operator=(index_list&& other) noexcept
+	{
+		if (this != &other)
+		{
+			index_list moved(std::move(other));
+			swap(moved);
+		}
+		return *this;
+	}
+
+	~index_list()
+	{
+		clear();
+		deallocateSlots(slots);
+	}
+
+	void swap(index_list& other) noexcept
+	{
+		std::swap(slots, other.slots);
+		std::swap(slotCapacity, other.slotCapacity);
+		std::swap(used, other.used);
+		std::swap(freeHead, other.freeHead);
+		std::swap(nelms, other.nelms);
+	}
+
+	bool operator==(const index_list& other) const noexcept
+	{
+		if (size() != other.size())
+			return false;
+
+		for (index_type a = headNext(), b = other.headNext(); a != sentinel; a = slots[a].next, b = other.slots[b].next)
+			if (slots[a].value() != other.slots[b].value())
+				return false;
+
+		return true;
+	}
+
+	auto operator<=>(const index_list& other) const
+		requires std::three_way_comparable<T>
+	{
+		using ordering = std::compare_three_way_result_t<T>;
+		index_type a = headNext();
+		index_type b = other.headNext();
+
+		for (; a != sentinel && b != sentinel; a = slots[a].next, b = other.slots[b].next)
+			if (const ordering result = slots[a].value() <=> other.slots[b].value(); result != 0)
+				return result;
+
+		return ordering(size() <=> other.size());
+	}
+
+	template <typename... Args>
+	void emplace_back(Args &&...args)
+	{
+		emplaceBefore(acquireSentinel(), std::forward<Args>(args)...);
+	}
+
+	void push_back(const T& newvalue)
+	{
+		emplace_back(newvalue);
+	}
+
+	void push_back(T&& newvalue)
+	{
+		emplace_back(std::move(newvalue));
+	}
+
+	template<typename... Args>
+	void emplace_front(Args&& ...args)
+	{
+		const index_type where = acquireSentinel();
+		emplaceBefore(slots[where].next, std::forward<Args>(args)...);
+	}
+
+	void push_front(const T& newvalue)
+	{
+		emplace_front(newvalue);
+	}
+
+	void push_front(T&& newvalue)
+	{
+		emplace_front(std::move(newvalue));
+	}
+
+	void pop_back()
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		erase(slots[sentinel].previous);
+	}
+
+	void pop_front()
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		erase(slots[sentinel].next);
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept
+	{
+		return nelms;
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return nelms == 0;
+	}
+
+	[[nodiscard]] std::size_t capacity() const noexcept
+	{
+		return slotCapacity == 0 ? 0 : slotCapacity - 1;
+	}
+
+	void reserve(std::size_t elements)
+	{
+		if (elements >= npos)
+			throw std::length_error("index_list capacity exceeded");
+		if (elements + 1 > slotCapacity)
+			relocate(index_type(elements + 1));
+	}
+
+	T& front()
+	{
+		if (empty())
+			throw std::length_error("front called on empty list");
+		return slots[slots[sentinel].next].value();
+	}
+
+	T& back()
+	{
+		if (empty())
+			throw std::length_error("back called on empty list");
+		return slots[slots[sentinel].previous].value();
+	}
+
+	const T& front() const
+	{
+		if (empty())
+			throw std::length_error("front called on empty list");
+		return slots[slots[sentinel].next].value();
+	}
+
+	const T& back() const
+	{
+		if (empty())
+			throw std::length_error("back called on empty list");
+		return slots[slots[sentinel].previous].value();
+	}
+
+	void clear()
+	{
+		if (!slots)
+			return;
+
+		if constexpr (!std::is_trivially_destructible_v<T>)
+			for (index_type i = slots[sentinel].next; i != sentinel; i = slots[i].next)
+				slots[i].value().~T();
+
+		slots[sentinel].previous = sentinel;
+		slots[sentinel].next = sentinel;
+		used = 1;
+		freeHead = npos;
+		nelms = 0;
+	}
+
+	[[nodiscard]] iterator begin() noexcept { return { this, headNext() }; }
+	[[nodiscard]] iterator end() noexcept { return { this, sentinel }; }
+	[[nodiscard]] const_iterator begin() const noexcept { return { this, headNext() }; }
+	[[nodiscard]] const_iterator end() const noexcept { return { this, sentinel }; }
+	[[nodiscard]] const_iterator cbegin() const noexcept { return { this, headNext() }; }
+	[[nodiscard]] const_iterator cend() const noexcept { return { this, sentinel }; }
+	[[nodiscard]] reverse_iterator rbegin() noexcept { return { this, headPrevious() }; }
+	[[nodiscard]] reverse_iterator rend() noexcept { return { this, sentinel }; }
+	[[nodiscard]] const_reverse_iterator crbegin() const noexcept { return { this, headPrevious() }; }
+	[[nodiscard]] const_reverse_iterator crend() const noexcept { return { this, sentinel }; }
+
+	template<typename It, typename ...Args>
+		requires is_valid_iterator<index_list, It>::iteratorConcept
+	It emplace(It it, Args&& ... args)
+	{
+		acquireSentinel();
+		return It(this, emplaceBefore(it.position, std::forward<Args>(args)...));
+	}
+
+	template<typename It>
+		requires is_valid_iterator<index_list, It>::iteratorConcept
+	It pop(It it)
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		if (it.position == sentinel)
+			throw std::runtime_error("pop called on head");
+		const index_type next = slots[it.position].next;
+		erase(it.position);
+		return It(this, next);
+	}
+
+	template<typename It>
+		requires is_valid_iterator<index_list, It>::iteratorConcept
+	It insert(It it, const T& newvalue)
+	{
+		return emplace<It>(it, newvalue);
+	}
+
+	template<typename It>
+		requires is_valid_iterator<index_list, It>::iteratorConcept
+	It insert(It it, T&& newvalue)
+	{
+		return emplace<It>(it, std::move(newvalue));
+	}
+
+	template<class NoReverseIT>
+		requires std::same_as<NoReverseIT, iterator> || std::same_as<NoReverseIT, const_iterator>
+	NoReverseIT erase(NoReverseIT first, NoReverseIT last)
+	{
+		std::size_t totalRemoved = 0;
+		for (index_type i = first.position; i != last.position; i = slots[i].next)
+		{
+			if (i == sentinel)
+				throw std::runtime_error("erase range contains head");
+			++totalRemoved;
+		}
+
+		for (index_type i = first.position; i != last.position;)
+		{
+			const index_type next = slots[i].next;
+			erase(i);
+			i = next;
+		}
+
+		return last;
+	}
+
+	template<class Function>
+	Function for_each(Function function)
+	{
+		for (index_type i = headNext(); i != sentinel; i = slots[i].next)
+			function(slots[i].value());
+		return function;
+	}
+
+	template<class Function>
+	Function for_each(Function function) const
+	{
+		for (index_type i = headNext(); i != sentinel; i = slots[i].next)
+			function(slots[i].value());
+		return function;
+	}
+
+	template<class Condition>
+	[[nodiscard]] iterator find_if(Condition condition)
+	{
+		index_type i = headNext();
+		while (i != sentinel && !condition(std::as_const(slots[i].value())))
+			i = slots[i].next;
+		return { this, i };
+	}
+
+	template<class Condition>
+	[[nodiscard]] const_iterator find_if(Condition condition) const
+	{
+		index_type i = headNext();
+		while (i != sentinel && !condition(slots[i].value()))
+			i = slots[i].next;
+		return { this, i };
+	}
+
+	[[nodiscard]] iterator find(const T& target)
+	{
+		return find_if([&](const T& value) { return value == target; });
+	}
+
+	[[nodiscard]] const_iterator find(const T& target) const
+	{
+		return find_if([&](const T& value) { return value == target; });
+	}
+
+	[[nodiscard]] bool contains(const T& target) const
+	{
+		return find(target) != cend();
+	}
+
+	template<class Condition>
+	[[nodiscard]] std::size_t count_if(Condition condition) const
+	{
+		std::size_t total = 0;
+		for_each([&](const T& value) { total += bool(condition(value)); });
+		return total;
+	}
+
+	template<typename U, class BinaryOperation = std::plus<>>
+	[[nodiscard]] U accumulate(U init, BinaryOperation operation = {}) const
+	{
+		for_each([&](const T& value) { init = operation(std::move(init), value); });
+		return init;
+	}
+
+	template<class Condition>
+	std::size_t remove_if(Condition condition)
+	{
+		const std::size_t before = nelms;
+		for (index_type i = headNext(); i != sentinel;)
+		{
+			const index_type next = slots[i].next;
+			if (condition(std::as_const(slots[i].value())))
+				erase(i);
+			i = next;
+		}
+		return before - nelms;
+	}
+
+	template<class Condition>
+	index_list extract_if(Condition condition)
+	{
+		index_list removed;
+		for (index_type i = headNext(); i != sentinel;)
+		{
+			const index_type next = slots[i].next;
+			if (condition(std::as_const(slots[i].value())))
+			{
+				removed.push_back(std::move(slots[i].value()));
+				erase(i);
+			}
+			i = next;
+		}
+		return removed;
+	}
+
+	template<typename It>
+		requires is_valid_iterator<index_list, It>::iteratorConcept
+	void splice(It where, index_list& rightlist)
+	{
+		if (rightlist.empty() || &rightlist == this)
+			return;
+
+		reserve(size() + rightlist.size());
+		index_type before = slots[where.position].next;
+		for (index_type i = rightlist.headNext(); i != sentinel; i = rightlist.slots[i].next)
+			emplaceBefore(before, std::move(rightlist.slots[i].value()));
+		rightlist.clear();
+	}
+
+	void sort()
+	{
+		if (nelms < 2)
+			return;
+
+		std::vector<index_type> order;
+		order.reserve(nelms);
+		for (index_type i = slots[sentinel].next; i != sentinel; i = slots[i].next)
+			order.push_back(i);
+
+		std::stable_sort(order.begin(), order.end(), [&](index_type a, index_type b)
+			{
+				return slots[a].value() < slots[b].value();
+			});
+
+		index_type previous = sentinel;
+		for (index_type i : order)
+		{
+			slots[previous].next = i;
+			slots[i].previous = previous;
+			previous = i;
+		}
+		slots[previous].next = sentinel;
+		slots[sentinel].previous = previous;
+	}
+};
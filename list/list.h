@@ -3,6 +3,39 @@
 #include<iostream>
 #include<utility>
 #include<functional>
+#include<algorithm>
+#include<memory>
+#include<stdexcept>
+#include<compare>
+#include<bit>
+#include<cstdint>
+#include<new>
+#include<array>
+#include<atomic>
+#include<optional>
+#include<vector>
+#include "simd.h"
+#include "list_stats.h"
+#include "parallel.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LIST_PREFETCH(address) __builtin_prefetch(address)
+#elif defined(_M_X64) || defined(_M_IX86)
+#include<xmmintrin.h>
+#define LIST_PREFETCH(address) _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0)
+#else
+#define LIST_PREFETCH(address) ((void)(address))
+#endif
+
+#if defined(__GLIBC__) && !defined(LIST_NO_MALLOC_USABLE_SIZE)
+#include<malloc.h>
+#define LIST_USABLE_SIZE(address, requested) malloc_usable_size(address)
+#elif defined(_MSC_VER) && !defined(LIST_NO_MALLOC_USABLE_SIZE)
+#include<malloc.h>
+#define LIST_USABLE_SIZE(address, requested) _msize(address)
+#else
+#define LIST_USABLE_SIZE(address, requested) (requested)
+#endif
 
 template<typename List, typename It>
 struct is_valid_iterator {
@@ -13,10 +46,11 @@ struct is_valid_iterator {
 		|| std::same_as<It, typename List::const_reverse_iterator>;
 };
 
-template<class T>
-class list
+template<typename Key>
+concept radix_sortable = std::integral<Key> || std::is_enum_v<Key>;
+
+namespace list_detail
 {
-private:
 	struct link
 	{
 		link* previous;
@@ -43,6 +77,7 @@ private:
 		virtual ~link() {}
 	};
 
+	template<class T>
 	struct node : public link
 	{
 		T value;
@@ -56,8 +91,440 @@ private:
 			: link(prev, nxt), value(std::forward<Args>(args)...) {}
 	};
 
+	template<class T>
+	struct slab;
+
+	template<class T>
+	struct slab_node : public node<T>
+	{
+		using node<T>::node;
+
+		static void* operator new(std::size_t, void* where) noexcept { return where; }
+		static void operator delete(void*, void*) noexcept {}
+
+		static void operator delete(void* where) noexcept
+		{
+			slab<T>::release(where);
+		}
+	};
+
+	template<class T>
+	struct slab
+	{
+		std::atomic<std::size_t> live;
+
+		static constexpr std::size_t header = (sizeof(std::atomic<std::size_t>) + alignof(slab_node<T>) - 1) / alignof(slab_node<T>) * alignof(slab_node<T>);
+		static constexpr std::size_t bytes = std::bit_ceil(std::max<std::size_t>(std::size_t(1) << 16, header + 64 * sizeof(slab_node<T>)));
+		static constexpr std::size_t capacity = (bytes - header) / sizeof(slab_node<T>);
+
+		static slab* allocate()
+		{
+			return new (::operator new(bytes, std::align_val_t(bytes))) slab{ 0 };
+		}
+
+		static void destroy(slab* target) noexcept
+		{
+			::operator delete(target, std::align_val_t(bytes));
+		}
+
+		static void release(void* where) noexcept
+		{
+			slab* owner = reinterpret_cast<slab*>(reinterpret_cast<std::uintptr_t>(where) & ~(std::uintptr_t(bytes) - 1));
+			if (owner->live.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				destroy(owner);
+		}
+
+		void* slot(std::size_t index) noexcept
+		{
+			return reinterpret_cast<std::byte*>(this) + header + index * sizeof(slab_node<T>);
+		}
+	};
+
+	template<class T>
+	class node_handle;
+}
+
+template<class T, class Stats = list_stats::disabled>
+class list
+{
+private:
+	using link = list_detail::link;
+	using node = list_detail::node<T>;
+	using slab = list_detail::slab<T>;
+	using slab_node = list_detail::slab_node<T>;
+
+	struct slab_filler
+	{
+		slab* current = nullptr;
+		std::size_t slot = slab::capacity;
+
+		slab_filler() = default;
+		slab_filler(const slab_filler&) = delete;
+		slab_filler& operator=(const slab_filler&) = delete;
+
+		~slab_filler()
+		{
+			release();
+		}
+
+		void* reserve()
+		{
+			if (slot == slab::capacity)
+			{
+				release();
+				current = slab::allocate();
+				slot = 0;
+			}
+			return current->slot(slot);
+		}
+
+		void commit() noexcept
+		{
+			current->live.fetch_add(1, std::memory_order_relaxed);
+			++slot;
+		}
+
+		void release() noexcept
+		{
+			if (current && current->live.load(std::memory_order_acquire) == 0)
+				slab::destroy(current);
+			current = nullptr;
+		}
+	};
+
 	link head;
 	std::size_t nelms;
+	[[no_unique_address]] mutable Stats counters;
+
+	void record(list_stats::counter which, std::uint64_t n = 1) const noexcept
+	{
+		if constexpr (Stats::enabled)
+			counters.add(which, n);
+	}
+
+	[[nodiscard]] auto timeOperation(list_stats::operation op) const noexcept
+	{
+		if constexpr (Stats::timed)
+			return counters.time(op);
+		else
+			return list_stats::no_timer{};
+	}
+
+	void trace(list_stats::trace_op op, std::uint64_t index, std::uint64_t count = 1, std::uint64_t valueBytes = 0) const
+	{
+		if constexpr (Stats::traced)
+			counters.emit({ op, index, count, valueBytes });
+	}
+
+	void traceAt(list_stats::trace_op op, const link* position, std::uint64_t count = 1, std::uint64_t valueBytes = 0) const
+	{
+		if constexpr (Stats::traced)
+		{
+			std::uint64_t index = 0;
+			for (const link* current = head.next; current != position && current != &head; current = current->next)
+				++index;
+			trace(op, index, count, valueBytes);
+		}
+	}
+
+	void releaseNodes() noexcept
+	{
+		link* aux = head.next;
+		while (aux != &head)
+		{
+			node* target = static_cast<node*>(aux);
+			aux = aux->next;
+			delete target;
+		}
+
+		record(list_stats::counter::deallocations, nelms);
+		nelms = 0;
+		head.next = &head;
+		head.previous = &head;
+		resetFingerprint();
+	}
+
+	static constexpr std::uint64_t fingerprint_boundary = 0x6a09e667f3bcc909ull;
+
+	static std::uint64_t scramble(std::uint64_t value) noexcept
+	{
+		value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+		value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+		return value ^ (value >> 31);
+	}
+
+	static std::uint64_t pairHash(std::uint64_t left, std::uint64_t right) noexcept
+	{
+		return scramble(left * 0x9e3779b97f4a7c15ull + scramble(right));
+	}
+
+	static std::uint64_t hashOf(const link* position, const link* boundary)
+	{
+		if (position == boundary)
+			return fingerprint_boundary;
+		return scramble(std::uint64_t(std::hash<T>{}(static_cast<const node*>(position)->value)));
+	}
+
+	std::uint64_t chainFingerprint(const link* first, const link* last) const
+	{
+		const std::uint64_t before = hashOf(first->previous, &head);
+		const std::uint64_t after = hashOf(last->next, &head);
+		std::uint64_t delta = pairHash(before, hashOf(first, &head)) + pairHash(hashOf(last, &head), after) - pairHash(before, after);
+		for (const link* current = first; current != last; current = current->next)
+			delta += pairHash(hashOf(current, &head), hashOf(current->next, &head));
+		return delta;
+	}
+
+	std::uint64_t computeFingerprint() const
+	{
+		std::uint64_t total = 0;
+		const link* current = &head;
+		do
+		{
+			total += pairHash(hashOf(current, &head), hashOf(current->next, &head));
+			current = current->next;
+		} while (current != &head);
+		return total - pairHash(fingerprint_boundary, fingerprint_boundary);
+	}
+
+	void noteModification() noexcept
+	{
+		if constexpr (Stats::maintained)
+			++counters.modifications;
+	}
+
+	std::uint64_t modificationCount() const noexcept
+	{
+		if constexpr (Stats::maintained)
+			return counters.modifications;
+		else
+			return 0;
+	}
+
+	void fingerprintLinked(const link* first, const link* last)
+	{
+		noteModification();
+		if constexpr (Stats::fingerprinted)
+			counters.value += chainFingerprint(first, last);
+	}
+
+	void fingerprintUnlinking(const link* first, const link* last)
+	{
+		noteModification();
+		if constexpr (Stats::fingerprinted)
+			counters.value -= chainFingerprint(first, last);
+	}
+
+	void refreshFingerprint()
+	{
+		if constexpr (Stats::fingerprinted)
+			counters.value = computeFingerprint();
+	}
+
+	void resetFingerprint() noexcept
+	{
+		noteModification();
+		if constexpr (Stats::fingerprinted)
+			counters.value = 0;
+	}
+
+	std::vector<link*> splitPoints(std::size_t parts) const
+	{
+		parts = std::max<std::size_t>(1, std::min(parts, nelms));
+		const std::size_t chunk = (nelms + parts - 1) / std::max<std::size_t>(parts, 1);
+		std::vector<link*> bounds;
+		bounds.reserve(parts + 1);
+
+		std::size_t i = 0;
+		for (link* current = head.next; current != &head; current = current->next, ++i)
+			if (i % chunk == 0)
+				bounds.push_back(current);
+		if (bounds.empty())
+			bounds.push_back(const_cast<link*>(&head));
+		bounds.push_back(const_cast<link*>(&head));
+		return bounds;
+	}
+
+	template<class Executor, class Kernel>
+	void runChunks(Executor&& executor, const std::vector<link*>& bounds, Kernel kernel) const
+	{
+		list_parallel::run(std::forward<Executor>(executor), bounds.size() - 1,
+			[&](std::size_t part) { kernel(part, bounds[part], bounds[part + 1]); });
+	}
+
+	template<class Executor, class Condition>
+	link* parallelFind(Executor&& executor, const std::vector<link*>& bounds, const Condition& condition) const
+	{
+		constexpr std::size_t none = ~std::size_t(0);
+		std::atomic<std::size_t> best{ none };
+		std::vector<link*> hits(bounds.size() - 1, nullptr);
+
+		runChunks(std::forward<Executor>(executor), bounds, [&](std::size_t part, link* first, link* last)
+			{
+				for (link* current = first; current != last; current = current->next)
+				{
+					if (best.load(std::memory_order_relaxed) < part)
+						return;
+					if (condition(std::as_const(static_cast<node*>(current)->value)))
+					{
+						hits[part] = current;
+						std::size_t expected = best.load(std::memory_order_relaxed);
+						while (part < expected && !best.compare_exchange_weak(expected, part, std::memory_order_relaxed))
+							;
+						return;
+					}
+				}
+			});
+
+		const std::size_t found = best.load();
+		return found == none ? const_cast<link*>(&head) : hits[found];
+	}
+
+	template<class Executor, class Condition>
+	std::size_t parallelCount(Executor&& executor, const std::vector<link*>& bounds, const Condition& condition) const
+	{
+		std::vector<std::size_t> partials(bounds.size() - 1, 0);
+		runChunks(std::forward<Executor>(executor), bounds, [&](std::size_t part, link* first, link* last)
+			{
+				std::size_t total = 0;
+				for (link* current = first; current != last; current = current->next)
+					total += bool(condition(std::as_const(static_cast<node*>(current)->value)));
+				partials[part] = total;
+			});
+
+		std::size_t total = 0;
+		for (std::size_t partial : partials)
+			total += partial;
+		return total;
+	}
+
+	template<class Executor, typename U, class BinaryOperation>
+	U parallelReduce(Executor&& executor, const std::vector<link*>& bounds, U init, const BinaryOperation& operation) const
+	{
+		std::vector<std::optional<U>> partials(bounds.size() - 1);
+		runChunks(std::forward<Executor>(executor), bounds, [&](std::size_t part, link* first, link* last)
+			{
+				if (first == last)
+					return;
+				U partial(std::as_const(static_cast<node*>(first)->value));
+				for (link* current = first->next; current != last; current = current->next)
+					partial = operation(std::move(partial), std::as_const(static_cast<node*>(current)->value));
+				partials[part].emplace(std::move(partial));
+			});
+
+		for (auto& partial : partials)
+			if (partial)
+				init = operation(std::move(init), std::move(*partial));
+		return init;
+	}
+
+	template<class Projection>
+	struct ranked
+	{
+		using projected = std::invoke_result_t<Projection&, const T&>;
+		using stored = std::conditional_t<std::is_reference_v<projected>, const std::remove_reference_t<projected>*, projected>;
+
+		stored cached;
+		link* position;
+		std::size_t order;
+
+		ranked(Projection& projection, link* position_, std::size_t order_)
+			: cached(project(projection, position_)), position(position_), order(order_) {}
+
+		static stored project(Projection& projection, link* position)
+		{
+			if constexpr (std::is_reference_v<projected>)
+				return &std::invoke(projection, std::as_const(static_cast<node*>(position)->value));
+			else
+				return std::invoke(projection, std::as_const(static_cast<node*>(position)->value));
+		}
+
+		const auto& key() const noexcept
+		{
+			if constexpr (std::is_reference_v<projected>)
+				return *cached;
+			else
+				return cached;
+		}
+	};
+
+	template<class Compare, class Projection>
+	auto rankedOrder(Compare& compare)
+	{
+		return [this, &compare](const ranked<Projection>& left, const ranked<Projection>& right)
+			{
+				record(list_stats::counter::comparisons);
+				if (compare(left.key(), right.key()))
+					return true;
+				record(list_stats::counter::comparisons);
+				return !compare(right.key(), left.key()) && left.order < right.order;
+			};
+	}
+
+	template<class Compare, class Projection>
+	std::vector<ranked<Projection>> smallest(std::size_t k, Compare& compare, Projection& projection)
+	{
+		std::vector<ranked<Projection>> heap;
+		k = std::min(k, nelms);
+		if (k == 0)
+			return heap;
+		heap.reserve(k);
+		auto before = rankedOrder<Compare, Projection>(compare);
+
+		std::size_t order = 0;
+		for (link* current = head.next; current != &head; current = current->next, ++order)
+		{
+			ranked<Projection> candidate(projection, current, order);
+			if (heap.size() < k)
+			{
+				heap.push_back(std::move(candidate));
+				std::push_heap(heap.begin(), heap.end(), before);
+			}
+			else if (before(candidate, heap.front()))
+			{
+				std::pop_heap(heap.begin(), heap.end(), before);
+				heap.back() = std::move(candidate);
+				std::push_heap(heap.begin(), heap.end(), before);
+			}
+		}
+		record(list_stats::counter::nodes_walked, nelms);
+
+		std::sort_heap(heap.begin(), heap.end(), before);
+		return heap;
+	}
+
+	template<class Compare, class Projection>
+	std::vector<ranked<Projection>> rankAll(std::size_t k, Compare& compare, Projection& projection)
+	{
+		if (k >= nelms)
+			throw std::out_of_range("selection index out of range");
+
+		std::vector<ranked<Projection>> all;
+		all.reserve(nelms);
+		std::size_t order = 0;
+		for (link* current = head.next; current != &head; current = current->next)
+			all.emplace_back(projection, current, order++);
+		record(list_stats::counter::nodes_walked, nelms);
+
+		std::nth_element(all.begin(), all.begin() + std::ptrdiff_t(k), all.end(), rankedOrder<Compare, Projection>(compare));
+		return all;
+	}
+
+	void noteAppended(link* previousLast, std::size_t appendedFrom)
+	{
+		const std::size_t appended = nelms - appendedFrom;
+		if (appended)
+			fingerprintLinked(previousLast->next, head.previous);
+		record(list_stats::counter::allocations, appended);
+		trace(list_stats::trace_op::push_back, appendedFrom, appended, appended ? list_stats::value_bytes(static_cast<node*>(head.previous)->value) : 0);
+	}
+
+	void noteChurn() noexcept
+	{
+		if constexpr (Stats::maintained)
+			if (counters.defragment_threshold > 0)
+				++counters.churn;
+	}
 
 	void deepCopy(const list& list)
 	{
@@ -72,6 +539,8 @@ private:
 		}
 	}
 
+	using element_reference = std::conditional_t<Stats::fingerprinted, const T&, T&>;
+
 	class iteratorImpl
 	{
 	private:
@@ -112,31 +581,235 @@ private:
 	template<class It>
 	link* popPosition(It it)
 	{
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::erase);
 		if (empty())
 			throw std::length_error("pop called on empty list");
 		node* target = dynamic_cast<node*>(it.pimpl.get()->linker);
 		if (!target)
 			throw std::runtime_error("pop called on head");
 		link** itlinker = &(it.pimpl.get()->linker);
+		traceAt(list_stats::trace_op::erase, *itlinker);
+		fingerprintUnlinking(target, target);
 		link* next = (*itlinker)->next;
 		(*itlinker)->previous->next = next;
 		next->previous = (*itlinker)->previous;
 		delete target;
+		record(list_stats::counter::deallocations);
 		--nelms;
+		noteChurn();
 		return next;
 	}
 
 	template<typename It, typename ...Args>
 	link* emplaceAt(It it, Args&& ...args)
 	{
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::insert);
 		link** itlinker = &(it.pimpl.get()->linker);
 		link* newnode = new node((*itlinker)->previous, (*itlinker), std::forward<Args>(args)...);
+		record(list_stats::counter::allocations);
 		(*itlinker)->previous->next = newnode;
 		(*itlinker)->previous = newnode;
 		++nelms;
+		fingerprintLinked(newnode, newnode);
+		noteChurn();
+		traceAt(list_stats::trace_op::insert, newnode, 1, list_stats::value_bytes(static_cast<node*>(newnode)->value));
 		return newnode;
 	}
 
+	template<std::size_t Distance, class Visitor>
+	link* walkUntil(Visitor visitor) const
+	{
+		link* sentinel = const_cast<link*>(&head);
+		link* current = sentinel->next;
+		link* ahead = current;
+		std::uint64_t walked = 0;
+
+		if constexpr (Distance > 0)
+			for (std::size_t i = 0; i < Distance && ahead != sentinel; ++i)
+				ahead = ahead->next;
+
+		while (current != sentinel)
+		{
+			if constexpr (Distance > 0)
+				if (ahead != sentinel)
+				{
+					ahead = ahead->next;
+					LIST_PREFETCH(ahead);
+				}
+
+			++walked;
+			if (visitor(static_cast<node*>(current)->value))
+			{
+				record(list_stats::counter::nodes_walked, walked);
+				trace(list_stats::trace_op::traverse, 0, walked);
+				return current;
+			}
+			current = current->next;
+		}
+
+		record(list_stats::counter::nodes_walked, walked);
+		trace(list_stats::trace_op::traverse, 0, walked);
+		return sentinel;
+	}
+
+	template<class Kernel>
+	void gatherChunks(Kernel kernel) const
+	{
+		T buffer[list_simd::gather_chunk];
+		std::size_t filled = 0;
+
+		walkUntil<prefetch_distance>([&](T& value)
+			{
+				buffer[filled++] = value;
+				if (filled == list_simd::gather_chunk)
+				{
+					kernel(buffer, filled);
+					filled = 0;
+				}
+				return false;
+			});
+
+		if (filled)
+			kernel(buffer, filled);
+	}
+
+	template<class Kernel>
+	bool gatherPairs(const list& other, Kernel kernel) const
+	{
+		T left[list_simd::gather_chunk];
+		T right[list_simd::gather_chunk];
+		const link* thislist = head.next;
+		const link* arglist = other.head.next;
+
+		while (thislist != &head && arglist != &other.head)
+		{
+			std::size_t filled = 0;
+			while (filled < list_simd::gather_chunk && thislist != &head && arglist != &other.head)
+			{
+				left[filled] = static_cast<const node*>(thislist)->value;
+				right[filled] = static_cast<const node*>(arglist)->value;
+				++filled;
+				thislist = thislist->next;
+				arglist = arglist->next;
+			}
+
+			record(list_stats::counter::nodes_walked, 2 * filled);
+			if (kernel(left, right, filled))
+				return true;
+		}
+
+		return false;
+	}
+
+	void unlinkRange(link* first, link* last) noexcept
+	{
+		noteModification();
+		first->previous->next = last->next;
+		last->next->previous = first->previous;
+	}
+
+	void linkRangeBefore(link* where, link* first, link* last) noexcept
+	{
+		noteModification();
+		first->previous = where->previous;
+		last->next = where;
+		where->previous->next = first;
+		where->previous = last;
+	}
+
+	static constexpr std::size_t radix_min_elements = 64;
+
+	template<class Key>
+	static auto radixKey(Key value) noexcept
+	{
+		if constexpr (std::is_enum_v<Key>)
+			return radixKey(static_cast<std::underlying_type_t<Key>>(value));
+		else if constexpr (std::is_signed_v<Key>)
+			return std::make_unsigned_t<Key>(std::make_unsigned_t<Key>(value) ^ (std::make_unsigned_t<Key>(1) << (8 * sizeof(Key) - 1)));
+		else
+			return value;
+	}
+
+	template<class Compare>
+	void sortByMerging(Compare& compare)
+	{
+		if (nelms < 2)
+			return;
+
+		auto counted = [&](const T& left, const T& right)
+			{
+				record(list_stats::counter::comparisons);
+				return compare(left, right);
+			};
+
+		head.previous->next = nullptr;
+		link* bins[64] = {};
+		std::size_t usedBins = 0;
+
+		for (link* aux = head.next; aux;)
+		{
+			link* carry = aux;
+			aux = aux->next;
+			carry->next = nullptr;
+
+			std::size_t i = 0;
+			for (; i < usedBins && bins[i]; i++)
+			{
+				carry = mergeChains(bins[i], carry, counted);
+				bins[i] = nullptr;
+			}
+
+			bins[i] = carry;
+			if (i == usedBins)
+				++usedBins;
+		}
+
+		link* result = nullptr;
+		for (std::size_t i = 0; i < usedBins; i++)
+			if (bins[i])
+				result = result ? mergeChains(bins[i], result, counted) : bins[i];
+
+		noteModification();
+		head.next = result;
+		link* previous = &head;
+		for (link* current = result; current; current = current->next)
+		{
+			current->previous = previous;
+			previous = current;
+		}
+		previous->next = &head;
+		head.previous = previous;
+		refreshFingerprint();
+	}
+
+	template<class Compare>
+	link* mergeChains(link* left, link* right, Compare& compare)
+	{
+		link merged;
+		link* last = &merged;
+		std::uint64_t relinked = 0;
+
+		while (left && right)
+		{
+			if (compare(static_cast<node*>(right)->value, static_cast<node*>(left)->value))
+			{
+				last->next = right;
+				right = right->next;
+			}
+			else
+			{
+				last->next = left;
+				left = left->next;
+			}
+			last = last->next;
+			++relinked;
+		}
+
+		last->next = left ? left : right;
+		record(list_stats::counter::relinks, relinked);
+		return merged.next;
+	}
+
 	void swapElements(link* first, link* second)
 	{
 		if (first == second)
@@ -144,6 +817,8 @@ private:
 
 		if (first == &head || second == &head)
 			throw std::invalid_argument("You cant swap head");
+		record(list_stats::counter::relinks, 2);
+		noteModification();
 
 		link* beforeFirst = first->previous;
 		link* afterFirst = first->next;
@@ -214,15 +889,15 @@ public:
 		nelms = 0;
 	}
 
-	list(const std::initializer_list<T>& list) : list()
+	list(const std::initializer_list<T>& ilist) : list()
 	{
-		for (const T& e : list)
+		for (const T& e : ilist)
 			push_back(e);
 	}
 
-	list(const list& list) : list()
+	list(const list& other) : list()
 	{
-		deepCopy(list);
+		deepCopy(other);
 	}
 
 	list& operator=(const list& list)
@@ -247,8 +922,19 @@ public:
 		if (empty() && list.empty())
 			return true;
 
+		if constexpr (Stats::fingerprinted)
+			if (counters.value != list.counters.value)
+				return false;
+
+		if constexpr (list_simd::vectorizable<T>)
+			return !gatherPairs(list, [](const T* left, const T* right, std::size_t n)
+				{
+					return list_simd::mismatch(left, right, n) != n;
+				});
+
 		while (thislist != &head && arglist != &list.head)
 		{
+			record(list_stats::counter::nodes_walked, 2);
 			if ((static_cast<node*>(thislist)->value) != (static_cast<node*>(arglist)->value))
 				return false;
 			thislist = thislist->next;
@@ -258,25 +944,82 @@ public:
 		return true;
 	}
 
-	list(list&& list) noexcept
+	auto operator<=>(const list& other) const
+		requires std::three_way_comparable<T>
 	{
-		nelms = list.nelms;
-		head.next = list.head.next;
-		head.previous = list.head.previous;
-		list.head.previous->next = &head;
-		list.head.next->previous = &head;
-		list.head.next = &list.head;
+		using ordering = std::compare_three_way_result_t<T>;
+		ordering result = ordering::equivalent;
+
+		if constexpr (list_simd::vectorizable<T>)
+		{
+			gatherPairs(other, [&](const T* left, const T* right, std::size_t n)
+				{
+					const std::size_t i = list_simd::mismatch(left, right, n);
+					if (i == n)
+						return false;
+					result = left[i] <=> right[i];
+					return true;
+				});
+		}
+		else
+		{
+			const link* thislist = head.next;
+			const link* arglist = other.head.next;
+			while (thislist != &head && arglist != &other.head && result == 0)
+			{
+				result = static_cast<const node*>(thislist)->value <=> static_cast<const node*>(arglist)->value;
+				thislist = thislist->next;
+				arglist = arglist->next;
+			}
+		}
+
+		if (result != 0)
+			return result;
+		return ordering(size() <=> other.size());
+	}
+
+	list(list&& list) noexcept
+	{
+		nelms = list.nelms;
+		if (nelms == 0)
+		{
+			head.next = &head;
+			head.previous = &head;
+		}
+		else
+		{
+			head.next = list.head.next;
+			head.previous = list.head.previous;
+			list.head.previous->next = &head;
+			list.head.next->previous = &head;
+		}
+		list.head.next = &list.head;
 		list.head.previous = &list.head;
 		list.nelms = 0;
+		list.noteModification();
+		if constexpr (Stats::maintained)
+			counters.defragment_threshold = list.counters.defragment_threshold;
+		if constexpr (Stats::fingerprinted)
+			counters.value = std::exchange(list.counters.value, 0);
+	}
+
+	~list()
+	{
+		releaseNodes();
 	}
 
 	template <typename... Args>
 	void emplace_back(Args &&...args)
 	{
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::insert);
 		node* new_node = new node(head.previous, &head, std::forward<Args>(args)...);
+		record(list_stats::counter::allocations);
 		head.previous->next = new_node;
 		head.previous = new_node;
 		++nelms;
+		fingerprintLinked(new_node, new_node);
+		trace(list_stats::trace_op::push_back, nelms - 1, 1, list_stats::value_bytes(new_node->value));
+		noteChurn();
 	}
 
 	void push_back(const T& newvalue)
@@ -292,10 +1035,15 @@ public:
 	template<typename... Args>
 	void emplace_front(Args&& ...args)
 	{
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::insert);
 		node* new_node = new node(&head, head.next, std::forward<Args>(args)...);
+		record(list_stats::counter::allocations);
 		head.next->previous = new_node;
 		head.next = new_node;
 		++nelms;
+		fingerprintLinked(new_node, new_node);
+		trace(list_stats::trace_op::push_front, 0, 1, list_stats::value_bytes(new_node->value));
+		noteChurn();
 	}
 
 	void push_front(const T& newvalue)
@@ -310,24 +1058,34 @@ public:
 
 	void pop_back()
 	{
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::erase);
 		if (empty())
 			throw std::length_error("pop called on empty list");
 		link* last = head.previous;
+		fingerprintUnlinking(last, last);
 		last->previous->next = &head;
 		head.previous = last->previous;
 		delete last;
+		record(list_stats::counter::deallocations);
 		--nelms;
+		trace(list_stats::trace_op::pop_back, nelms);
+		noteChurn();
 	}
 
 	void pop_front()
 	{
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::erase);
 		if (empty())
 			throw std::length_error("pop called on empty list");
 		link* front = head.next;
+		fingerprintUnlinking(front, front);
 		head.next = front->next;
 		front->next->previous = &head;
 		delete front;
+		record(list_stats::counter::deallocations);
 		--nelms;
+		trace(list_stats::trace_op::pop_front, 0);
+		noteChurn();
 	}
 
 	[[nodiscard]] std::size_t size() const noexcept
@@ -340,14 +1098,14 @@ public:
 		return nelms == 0;
 	}
 
-	T& front()
+	element_reference front()
 	{
 		if (empty())
 			throw std::length_error("front called on empty list");
 		return static_cast<node*>(head.next)->value;
 	}
 
-	T& back()
+	element_reference back()
 	{
 		if (empty())
 			throw std::length_error("back called on empty list");
@@ -370,17 +1128,8 @@ public:
 
 	void clear()
 	{
-		link* aux = head.next;
-		while (aux != &head)
-		{
-			node* target = static_cast<node*>(aux);
-			aux = aux->next;
-			delete target;
-		}
-
-		nelms = 0;
-		head.next = &head;
-		head.previous = &head;
+		trace(list_stats::trace_op::clear, 0, nelms);
+		releaseNodes();
 	}
 
 	class iterator
@@ -393,8 +1142,8 @@ public:
 		using iterator_category = std::bidirectional_iterator_tag;
 		using value_type = T;
 		using difference_type = std::ptrdiff_t;
-		using pointer = T*;
-		using reference = T&;
+		using pointer = std::remove_reference_t<element_reference>*;
+		using reference = element_reference;
 
 		iterator() : pimpl(nullptr) {}
 		iterator(link* linker) : pimpl(std::make_unique<iteratorImpl>(linker)) {}
@@ -433,7 +1182,7 @@ public:
 			return aux;
 		}
 
-		T& operator*()
+		reference operator*()
 		{
 			return pimpl.get()->getValue();
 		}
@@ -549,8 +1298,8 @@ public:
 		using iterator_category = std::bidirectional_iterator_tag;
 		using value_type = T;
 		using difference_type = std::ptrdiff_t;
-		using pointer = T*;
-		using reference = T&;
+		using pointer = std::remove_reference_t<element_reference>*;
+		using reference = element_reference;
 
 		reverse_iterator() : pimpl(nullptr) {}
 		reverse_iterator(const link* linker) :pimpl(std::make_unique<iteratorImpl>(const_cast<link*>(linker))) {}
@@ -597,7 +1346,7 @@ public:
 			return aux;
 		}
 
-		T& operator*() const
+		reference operator*() const
 		{
 			return pimpl.get()->getValue();
 		}
@@ -713,6 +1462,66 @@ public:
 		return &head;
 	}
 
+	using node_handle = list_detail::node_handle<T>;
+
+	template<typename It>
+		requires is_valid_iterator<list, It>::iteratorConcept
+	node_handle extract(It it)
+	{
+		if (empty())
+			throw std::length_error("extract called on empty list");
+		node* target = dynamic_cast<node*>(it.pimpl.get()->linker);
+		if (!target)
+			throw std::runtime_error("extract called on head");
+		traceAt(list_stats::trace_op::erase, target);
+		fingerprintUnlinking(target, target);
+		unlinkRange(target, target);
+		record(list_stats::counter::relinks);
+		--nelms;
+		return node_handle(target);
+	}
+
+	template<typename It>
+		requires is_valid_iterator<list, It>::iteratorConcept
+	It insert(It it, node_handle&& nh)
+	{
+		if (nh.empty())
+			throw std::invalid_argument("insert called with empty node handle");
+		node* target = std::exchange(nh.owned, nullptr);
+		linkRangeBefore(it.pimpl.get()->linker, target, target);
+		record(list_stats::counter::relinks);
+		++nelms;
+		fingerprintLinked(target, target);
+		traceAt(list_stats::trace_op::insert, target, 1, list_stats::value_bytes(target->value));
+		return It(target);
+	}
+
+	template<typename It, class Function>
+		requires is_valid_iterator<list, It>::iteratorConcept
+	void update(It it, Function function)
+	{
+		link* target = it.pimpl.get()->linker;
+		if (target == &head)
+			throw std::runtime_error("update called on head");
+		T& value = static_cast<node*>(target)->value;
+		if constexpr (Stats::fingerprinted)
+		{
+			counters.value -= chainFingerprint(target, target);
+			try
+			{
+				function(value);
+			}
+			catch (...)
+			{
+				counters.value += chainFingerprint(target, target);
+				throw;
+			}
+			counters.value += chainFingerprint(target, target);
+		}
+		else
+			function(value);
+	}
+
 	template<typename It, typename ...Args>
 		requires is_valid_iterator<list, It>::iteratorConcept
 	It emplace(It it, Args&& ... args)
@@ -741,30 +1550,583 @@ public:
 		return emplace<It>(it, std::move(newvalue));
 	}
 
+	static constexpr std::size_t prefetch_distance = 0;
+
+	template<std::size_t Distance = prefetch_distance, class Function>
+	Function for_each(Function function)
+	{
+		walkUntil<Distance>([&](T& value) { function(value); return false; });
+		refreshFingerprint();
+		return function;
+	}
+
+	template<std::size_t Distance = prefetch_distance, class Function>
+	Function for_each(Function function) const
+	{
+		walkUntil<Distance>([&](T& value) { function(std::as_const(value)); return false; });
+		return function;
+	}
+
+	template<std::size_t Distance = prefetch_distance, class Condition>
+	[[nodiscard]] iterator find_if(Condition condition)
+	{
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::search);
+		return walkUntil<Distance>([&](T& value) { return bool(condition(std::as_const(value))); });
+	}
+
+	template<std::size_t Distance = prefetch_distance, class Condition>
+	[[nodiscard]] const_iterator find_if(Condition condition) const
+	{
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::search);
+		return walkUntil<Distance>([&](T& value) { return bool(condition(std::as_const(value))); });
+	}
+
+	template<std::size_t Distance = prefetch_distance>
+	[[nodiscard]] iterator find(const T& target)
+	{
+		return find_if<Distance>([&](const T& value) { return value == target; });
+	}
+
+	template<std::size_t Distance = prefetch_distance>
+	[[nodiscard]] const_iterator find(const T& target) const
+	{
+		return find_if<Distance>([&](const T& value) { return value == target; });
+	}
+
+	template<std::size_t Distance = prefetch_distance>
+	[[nodiscard]] bool contains(const T& target) const
+	{
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::search);
+		return walkUntil<Distance>([&](T& value) { return value == target; }) != &head;
+	}
+
+	template<std::size_t Distance = prefetch_distance, class Condition>
+	[[nodiscard]] std::size_t count_if(Condition condition) const
+	{
+		std::size_t total = 0;
+		walkUntil<Distance>([&](T& value) { total += bool(condition(std::as_const(value))); return false; });
+		return total;
+	}
+
+	template<std::size_t Distance = prefetch_distance, typename U, class BinaryOperation = std::plus<>>
+	[[nodiscard]] U accumulate(U init, BinaryOperation operation = {}) const
+	{
+		walkUntil<Distance>([&](T& value) { init = operation(std::move(init), std::as_const(value)); return false; });
+		return init;
+	}
+
+	class split_index
+	{
+	private:
+		std::vector<link*> bounds;
+		const list* owner;
+		std::size_t elements;
+		std::uint64_t modifications;
+
+		split_index(std::vector<link*> bounds_, const list* owner_)
+			: bounds(std::move(bounds_)), owner(owner_), elements(owner_->nelms), modifications(owner_->modificationCount()) {}
+
+		const std::vector<link*>& boundsFor(const list& target) const
+		{
+			if (owner != &target || elements != target.nelms || modifications != target.modificationCount())
+				throw std::invalid_argument("split index does not match this list");
+			return bounds;
+		}
+
+	public:
+		friend class list;
+
+		[[nodiscard]] std::size_t parts() const noexcept
+		{
+			return bounds.size() - 1;
+		}
+	};
+
+	[[nodiscard]] split_index make_split_index(std::size_t parts = 0) const
+	{
+		return split_index(splitPoints(parts ? parts : list_parallel::parts_for(nelms)), this);
+	}
+
+	template<list_parallel::executor Executor, class Function>
+	void for_each(Executor&& executor, const split_index& index, Function function)
+	{
+		runChunks(std::forward<Executor>(executor), index.boundsFor(*this), [&](std::size_t, link* first, link* last)
+			{
+				for (link* current = first; current != last; current = current->next)
+					std::as_const(function)(static_cast<node*>(current)->value);
+			});
+		refreshFingerprint();
+	}
+
+	template<list_parallel::executor Executor, class Function>
+	void for_each(Executor&& executor, Function function)
+	{
+		for_each(std::forward<Executor>(executor), make_split_index(), std::move(function));
+	}
+
+	template<list_parallel::executor Executor, class Function>
+	void for_each(Executor&& executor, const split_index& index, Function function) const
+	{
+		runChunks(std::forward<Executor>(executor), index.boundsFor(*this), [&](std::size_t, link* first, link* last)
+			{
+				for (link* current = first; current != last; current = current->next)
+					std::as_const(function)(std::as_const(static_cast<node*>(current)->value));
+			});
+	}
+
+	template<list_parallel::executor Executor, class Function>
+	void for_each(Executor&& executor, Function function) const
+	{
+		for_each(std::forward<Executor>(executor), make_split_index(), std::move(function));
+	}
+
+	template<list_parallel::executor Executor, class Function>
+	void transform(Executor&& executor, const split_index& index, Function function)
+	{
+		for_each(std::forward<Executor>(executor), index, [&](T& value) { value = std::as_const(function)(std::as_const(value)); });
+	}
+
+	template<list_parallel::executor Executor, class Function>
+	void transform(Executor&& executor, Function function)
+	{
+		transform(std::forward<Executor>(executor), make_split_index(), std::move(function));
+	}
+
+	template<list_parallel::executor Executor, class Condition>
+	[[nodiscard]] std::size_t count_if(Executor&& executor, const split_index& index, Condition condition) const
+	{
+		return parallelCount(std::forward<Executor>(executor), index.boundsFor(*this), condition);
+	}
+
+	template<list_parallel::executor Executor, class Condition>
+	[[nodiscard]] std::size_t count_if(Executor&& executor, Condition condition) const
+	{
+		return count_if(std::forward<Executor>(executor), make_split_index(), std::move(condition));
+	}
+
+	template<list_parallel::executor Executor, class Condition>
+	[[nodiscard]] iterator find_if(Executor&& executor, const split_index& index, Condition condition)
+	{
+		return parallelFind(std::forward<Executor>(executor), index.boundsFor(*this), condition);
+	}
+
+	template<list_parallel::executor Executor, class Condition>
+	[[nodiscard]] iterator find_if(Executor&& executor, Condition condition)
+	{
+		return find_if(std::forward<Executor>(executor), make_split_index(), std::move(condition));
+	}
+
+	template<list_parallel::executor Executor, class Condition>
+	[[nodiscard]] const_iterator find_if(Executor&& executor, const split_index& index, Condition condition) const
+	{
+		return parallelFind(std::forward<Executor>(executor), index.boundsFor(*this), condition);
+	}
+
+	template<list_parallel::executor Executor, class Condition>
+	[[nodiscard]] const_iterator find_if(Executor&& executor, Condition condition) const
+	{
+		return find_if(std::forward<Executor>(executor), make_split_index(), std::move(condition));
+	}
+
+	template<list_parallel::executor Executor>
+	[[nodiscard]] iterator find(Executor&& executor, const T& target)
+	{
+		return find_if(std::forward<Executor>(executor), [&](const T& value) { return value == target; });
+	}
+
+	template<list_parallel::executor Executor>
+	[[nodiscard]] const_iterator find(Executor&& executor, const T& target) const
+	{
+		return find_if(std::forward<Executor>(executor), [&](const T& value) { return value == target; });
+	}
+
+	template<list_parallel::executor Executor, typename U, class BinaryOperation = std::plus<>>
+	[[nodiscard]] U reduce(Executor&& executor, const split_index& index, U init, BinaryOperation operation = {}) const
+	{
+		return parallelReduce(std::forward<Executor>(executor), index.boundsFor(*this), std::move(init), operation);
+	}
+
+	template<list_parallel::executor Executor, typename U, class BinaryOperation = std::plus<>>
+		requires (!std::same_as<U, split_index>)
+	[[nodiscard]] U reduce(Executor&& executor, U init, BinaryOperation operation = {}) const
+	{
+		return reduce(std::forward<Executor>(executor), make_split_index(), std::move(init), std::move(operation));
+	}
+
+	[[nodiscard]] T sum() const
+		requires list_simd::vectorizable<T>
+	{
+		T total{};
+		gatherChunks([&](const T* data, std::size_t n) { total += list_simd::sum(data, n); });
+		return total;
+	}
+
+	[[nodiscard]] T min() const
+		requires list_simd::vectorizable<T>
+	{
+		if (empty())
+			throw std::length_error("min called on empty list");
+		T result = front();
+		gatherChunks([&](const T* data, std::size_t n)
+			{
+				const T chunkMin = list_simd::min(data, n);
+				result = chunkMin < result ? chunkMin : result;
+			});
+		return result;
+	}
+
+	[[nodiscard]] T max() const
+		requires list_simd::vectorizable<T>
+	{
+		if (empty())
+			throw std::length_error("max called on empty list");
+		T result = front();
+		gatherChunks([&](const T* data, std::size_t n)
+			{
+				const T chunkMax = list_simd::max(data, n);
+				result = result < chunkMax ? chunkMax : result;
+			});
+		return result;
+	}
+
+	[[nodiscard]] std::size_t count(const T& target) const
+	{
+		if constexpr (list_simd::vectorizable<T>)
+		{
+			std::size_t total = 0;
+			gatherChunks([&](const T* data, std::size_t n) { total += list_simd::count(data, n, target); });
+			return total;
+		}
+		else
+			return count_if([&](const T& value) { return value == target; });
+	}
+
+	static constexpr std::size_t page_bytes = 4096;
+	static constexpr std::size_t auto_defragment_min_churn = 1024;
+	static constexpr std::size_t slab_min_nodes = 64;
+	static constexpr std::size_t node_bytes = sizeof(node);
+
+	struct locality_report
+	{
+		double average_distance;
+		double page_crossings;
+		double score;
+	};
+
+	[[nodiscard]] locality_report locality() const noexcept
+	{
+		if (nelms < 2)
+			return { 0, 0, 1 };
+
+		double totalDistance = 0;
+		std::size_t crossings = 0;
+		std::size_t localHops = 0;
+
+		for (const link* current = head.next; current->next != &head; current = current->next)
+		{
+			const auto from = reinterpret_cast<std::uintptr_t>(current);
+			const auto to = reinterpret_cast<std::uintptr_t>(current->next);
+			totalDistance += double(from < to ? to - from : from - to);
+			crossings += from / page_bytes != to / page_bytes;
+			localHops += from < to && to - from <= page_bytes;
+		}
+
+		const double hops = double(nelms - 1);
+		return { totalDistance / hops, double(crossings) / hops, double(localHops) / hops };
+	}
+
+	[[nodiscard]] double locality_score() const noexcept
+	{
+		return locality().score;
+	}
+
+	struct memory_report
+	{
+		std::size_t nodes;
+		std::size_t payload_bytes;
+		std::size_t link_bytes;
+		std::size_t vptr_bytes;
+		std::size_t padding_bytes;
+		std::size_t allocator_slack_bytes;
+		std::size_t slabs;
+		std::size_t cached_nodes;
+		std::size_t cached_bytes;
+		std::size_t header_bytes;
+
+		[[nodiscard]] std::size_t total_bytes() const noexcept
+		{
+			return payload_bytes + link_bytes + vptr_bytes + padding_bytes + allocator_slack_bytes + cached_bytes + header_bytes;
+		}
+
+		[[nodiscard]] double overhead_ratio() const noexcept
+		{
+			return payload_bytes ? double(total_bytes() - payload_bytes) / double(payload_bytes) : 0;
+		}
+	};
+
+	struct detailed_memory_report
+	{
+		static constexpr std::size_t buckets = 48;
+
+		memory_report usage;
+		std::size_t contiguous_hops;
+		std::size_t backward_hops;
+		std::array<std::size_t, buckets> distance_histogram;
+	};
+
+	[[nodiscard]] memory_report memory_usage() const
+	{
+		memory_report report{};
+		report.nodes = nelms;
+		report.payload_bytes = nelms * sizeof(T);
+		report.link_bytes = nelms * 2 * sizeof(link*);
+		report.vptr_bytes = nelms * (sizeof(link) - 2 * sizeof(link*));
+		report.padding_bytes = nelms * (sizeof(node) - sizeof(link) - sizeof(T));
+		report.header_bytes = sizeof(list);
+
+		std::vector<const slab*> slabs;
+		for (const link* current = head.next; current != &head; current = current->next)
+		{
+			if (dynamic_cast<const slab_node*>(current))
+				slabs.push_back(reinterpret_cast<const slab*>(reinterpret_cast<std::uintptr_t>(current) & ~(std::uintptr_t(slab::bytes) - 1)));
+			else
+				report.allocator_slack_bytes += std::size_t(LIST_USABLE_SIZE(const_cast<link*>(current), sizeof(node))) - sizeof(node);
+		}
+
+		std::sort(slabs.begin(), slabs.end());
+		slabs.erase(std::unique(slabs.begin(), slabs.end()), slabs.end());
+		for (const slab* owner : slabs)
+		{
+			const std::size_t live = owner->live.load(std::memory_order_acquire);
+			report.cached_nodes += slab::capacity - live;
+			report.cached_bytes += slab::bytes - live * sizeof(slab_node);
+		}
+		report.slabs = slabs.size();
+		return report;
+	}
+
+	[[nodiscard]] detailed_memory_report memory_usage_detailed() const
+	{
+		detailed_memory_report report{ memory_usage(), 0, 0, {} };
+		if (nelms < 2)
+			return report;
+
+		for (const link* current = head.next; current->next != &head; current = current->next)
+		{
+			const auto from = reinterpret_cast<std::uintptr_t>(current);
+			const auto to = reinterpret_cast<std::uintptr_t>(current->next);
+			const std::uintptr_t distance = from < to ? to - from : from - to;
+			report.contiguous_hops += from < to && distance == sizeof(node);
+			report.backward_hops += to < from;
+			++report.distance_histogram[std::min<std::size_t>(std::bit_width(distance), detailed_memory_report::buckets - 1)];
+		}
+		return report;
+	}
+
+	void defragment()
+		requires std::move_constructible<T>
+	{
+		slab_filler filler;
+		const bool pooled = nelms >= slab_min_nodes;
+
+		for (link* old = head.next; old != &head;)
+		{
+			node* target = static_cast<node*>(old);
+			link* moved = pooled ? new (filler.reserve()) slab_node(old->previous, old->next, std::move(target->value)) : new node(old->previous, old->next, std::move(target->value));
+			if (pooled)
+				filler.commit();
+			old->previous->next = moved;
+			old->next->previous = moved;
+			old = old->next;
+			delete target;
+		}
+
+		record(list_stats::counter::allocations, nelms);
+		record(list_stats::counter::deallocations, nelms);
+
+		if constexpr (Stats::maintained)
+			counters.churn = 0;
+		noteModification();
+	}
+
+	template<class Generator>
+	void append_n(std::size_t count, Generator generate)
+	{
+		slab_filler filler;
+		const bool pooled = count >= slab_min_nodes;
+		link* previousLast = head.previous;
+		const std::size_t appendedFrom = nelms;
+
+		try
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				link* newnode = pooled ? new (filler.reserve()) slab_node(head.previous, &head, generate()) : new node(head.previous, &head, generate());
+				if (pooled)
+					filler.commit();
+				head.previous->next = newnode;
+				head.previous = newnode;
+				++nelms;
+			}
+		}
+		catch (...)
+		{
+			noteAppended(previousLast, appendedFrom);
+			throw;
+		}
+
+		noteAppended(previousLast, appendedFrom);
+	}
+
+	void set_defragment_threshold(double threshold) noexcept
+		requires Stats::maintained
+	{
+		counters.defragment_threshold = threshold;
+		counters.churn = 0;
+	}
+
+	bool maintain()
+		requires Stats::maintained && std::move_constructible<T>
+	{
+		if (counters.defragment_threshold <= 0 || counters.churn < std::max<std::size_t>(nelms, auto_defragment_min_churn))
+			return false;
+		counters.churn = 0;
+		if (locality_score() >= counters.defragment_threshold)
+			return false;
+		defragment();
+		return true;
+	}
+
+	[[nodiscard]] list_stats::report stats() const noexcept
+		requires Stats::enabled
+	{
+		return counters.snapshot();
+	}
+
+	void reset_stats() noexcept
+		requires Stats::enabled
+	{
+		counters.reset();
+	}
+
+	[[nodiscard]] Stats& recorder() noexcept
+		requires Stats::traced
+	{
+		return counters;
+	}
+
+	[[nodiscard]] std::uint64_t fingerprint() const
+	{
+		if constexpr (Stats::fingerprinted)
+			return counters.value;
+		else
+			return computeFingerprint();
+	}
+
+	void refresh_fingerprint()
+		requires Stats::fingerprinted
+	{
+		refreshFingerprint();
+	}
+
 	template<class Condition>
 	std::size_t remove_if(Condition condition)
 	{
+		return extract_if(condition).size();
+	}
+
+	template<class Condition>
+	list extract_if(Condition condition)
+	{
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::remove_if);
+		list removed;
 		std::size_t totalRemoved = 0;
-		auto it = cbegin();
+		link* current = head.next;
+		record(list_stats::counter::remove_if_visits, nelms);
+		record(list_stats::counter::nodes_walked, nelms);
+
+		while (current != &head)
+		{
+			if (!condition(std::as_const(static_cast<node*>(current)->value)))
+			{
+				current = current->next;
+				continue;
+			}
+
+			link* first = current;
+			link* last = current;
+			++totalRemoved;
 
-		while (it != cend())
-			if (condition(*it))
+			while (last->next != &head && condition(std::as_const(static_cast<node*>(last->next)->value)))
 			{
-				it = pop(it);
+				last = last->next;
 				++totalRemoved;
 			}
-			else
-				++it;
 
-		return totalRemoved;
+			current = last->next;
+			unlinkRange(first, last);
+			linkRangeBefore(&removed.head, first, last);
+		}
+
+		record(list_stats::counter::relinks, totalRemoved);
+		trace(list_stats::trace_op::remove_if, nelms, totalRemoved);
+		nelms -= totalRemoved;
+		removed.nelms = totalRemoved;
+		if (totalRemoved)
+		{
+			refreshFingerprint();
+			removed.refreshFingerprint();
+		}
+		return removed;
+	}
+
+	template<class NoReverseIT>
+		requires std::same_as<NoReverseIT, iterator> || std::same_as<NoReverseIT, const_iterator>
+	NoReverseIT erase(NoReverseIT first, NoReverseIT last)
+	{
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::erase);
+		link* firstlinker = first.pimpl.get()->linker;
+		link* lastlinker = last.pimpl.get()->linker;
+
+		if (firstlinker == lastlinker)
+			return last;
+
+		std::size_t totalRemoved = 0;
+		for (link* aux = firstlinker; aux != lastlinker; aux = aux->next)
+		{
+			if (aux == &head)
+				throw std::runtime_error("erase range contains head");
+			++totalRemoved;
+		}
+
+		traceAt(list_stats::trace_op::erase_range, firstlinker, totalRemoved);
+		link* rangeEnd = lastlinker->previous;
+		fingerprintUnlinking(firstlinker, rangeEnd);
+		unlinkRange(firstlinker, rangeEnd);
+		rangeEnd->next = nullptr;
+
+		link* aux = firstlinker;
+		while (aux)
+		{
+			link* target = aux;
+			aux = aux->next;
+			delete target;
+		}
+
+		record(list_stats::counter::nodes_walked, totalRemoved);
+		record(list_stats::counter::deallocations, totalRemoved);
+		nelms -= totalRemoved;
+		return last;
 	}
 
 	template<typename It>
 		requires is_valid_iterator<list, It>::iteratorConcept
 	void splice(It where, list& rightlist)
 	{
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::splice);
 		link* lnk = where.pimpl.get()->linker;
 		link* nextE = lnk->next;
+		traceAt(list_stats::trace_op::splice, nextE, rightlist.size());
 
 		lnk->next = rightlist.head.next;
 		rightlist.head.next->previous = lnk;
@@ -772,14 +2134,30 @@ public:
 		nextE->previous = rightlist.head.previous;
 		rightlist.head.previous->next = nextE;
 
+		record(list_stats::counter::relinks, rightlist.size());
 		nelms += rightlist.size();
+		noteModification();
+		if constexpr (Stats::fingerprinted)
+			if (!rightlist.empty())
+			{
+				const std::uint64_t first = hashOf(lnk->next, &head);
+				const std::uint64_t last = hashOf(nextE->previous, &head);
+				const std::uint64_t before = hashOf(lnk, &head);
+				const std::uint64_t after = hashOf(nextE, &head);
+				counters.value += rightlist.counters.value
+					- pairHash(fingerprint_boundary, first) - pairHash(last, fingerprint_boundary) + pairHash(fingerprint_boundary, fingerprint_boundary)
+					+ pairHash(before, first) + pairHash(last, after) - pairHash(before, after);
+			}
 		rightlist.head.next = &rightlist.head;
 		rightlist.head.previous = &rightlist.head;
 		rightlist.nelms = 0;
+		rightlist.resetFingerprint();
 	}
 
 	void sort()
 	{
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::sort);
+		trace(list_stats::trace_op::sort, 0, nelms);
 		if (empty() || nelms == 1)
 			return;
 
@@ -787,6 +2165,7 @@ public:
 			{
 				const_iterator it = cbegin();
 				std::advance(it, pos);
+				record(list_stats::counter::nodes_walked, pos + 1);
 				return it.pimpl.get()->linker;
 			};
 
@@ -816,6 +2195,7 @@ public:
 
 					for (std::size_t i = begin; i < last; i++)
 					{
+						record(list_stats::counter::comparisons);
 						if (static_cast<node*>(getLinkerAt(i))->value < pivotValue)
 						{
 							swapElements(getLinkerAt(i), getLinkerAt(tracker));
@@ -831,5 +2211,263 @@ public:
 			};
 
 		quickSort(0, std::size_t(nelms - 1));
+		refreshFingerprint();
+	}
+
+	template<class Compare = std::less<>>
+	void merge_sort(Compare compare = {})
+	{
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::sort);
+		trace(list_stats::trace_op::sort, 0, nelms);
+		sortByMerging(compare);
+	}
+
+	template<class KeyFn = std::identity>
+		requires radix_sortable<std::remove_cvref_t<std::invoke_result_t<KeyFn&, const T&>>>
+	void radix_sort(KeyFn key = {})
+	{
+		using key_type = std::remove_cvref_t<std::invoke_result_t<KeyFn&, const T&>>;
+		using unsigned_key = decltype(radixKey(key_type{}));
+		constexpr std::size_t digits = sizeof(unsigned_key);
+
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::sort);
+		trace(list_stats::trace_op::sort, 0, nelms);
+		if (nelms < 2)
+			return;
+
+		auto keyOf = [&](link* current) { return radixKey(std::invoke(key, std::as_const(static_cast<node*>(current)->value))); };
+		auto byKey = [&](const T& left, const T& right) { return std::invoke(key, left) < std::invoke(key, right); };
+		if (nelms < radix_min_elements)
+		{
+			sortByMerging(byKey);
+			return;
+		}
+
+		std::array<std::array<std::size_t, 256>, digits> histograms{};
+		for (link* current = head.next; current != &head; current = current->next)
+		{
+			const unsigned_key value = keyOf(current);
+			for (std::size_t digit = 0; digit < digits; digit++)
+				++histograms[digit][std::size_t(value >> (8 * digit)) & 0xff];
+		}
+		record(list_stats::counter::nodes_walked, nelms);
+
+		std::array<bool, digits> needed{};
+		std::size_t passes = 0;
+		for (std::size_t digit = 0; digit < digits; digit++)
+		{
+			needed[digit] = std::ranges::find(histograms[digit], nelms) == histograms[digit].end();
+			passes += needed[digit];
+		}
+
+		if (10 * passes * (nelms + 256) >= 3 * nelms * std::size_t(std::bit_width(nelms)))
+		{
+			sortByMerging(byKey);
+			return;
+		}
+
+		head.previous->next = nullptr;
+		link* chain = head.next;
+		for (std::size_t digit = 0; digit < digits; digit++)
+		{
+			if (!needed[digit])
+				continue;
+
+			std::array<link*, 256> firsts{};
+			std::array<link*, 256> lasts{};
+			for (link* current = chain; current; current = current->next)
+			{
+				const std::size_t bucket = std::size_t(keyOf(current) >> (8 * digit)) & 0xff;
+				if (lasts[bucket])
+					lasts[bucket]->next = current;
+				else
+					firsts[bucket] = current;
+				lasts[bucket] = current;
+			}
+
+			link* tail = nullptr;
+			chain = nullptr;
+			for (std::size_t bucket = 0; bucket < 256; bucket++)
+			{
+				if (!firsts[bucket])
+					continue;
+				if (tail)
+					tail->next = firsts[bucket];
+				else
+					chain = firsts[bucket];
+				tail = lasts[bucket];
+			}
+			tail->next = nullptr;
+			record(list_stats::counter::nodes_walked, nelms);
+			record(list_stats::counter::relinks, nelms);
+		}
+
+		noteModification();
+		head.next = chain;
+		link* previous = &head;
+		for (link* current = chain; current; current = current->next)
+		{
+			current->previous = previous;
+			previous = current;
+		}
+		previous->next = &head;
+		head.previous = previous;
+		refreshFingerprint();
+	}
+
+	template<class Compare = std::less<>, class Projection = std::identity>
+	void partial_sort(std::size_t k, Compare compare = {}, Projection projection = {})
+	{
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::sort);
+		trace(list_stats::trace_op::sort, 0, std::min(k, nelms));
+
+		const auto selected = smallest(k, compare, projection);
+		for (const auto& entry : selected)
+			unlinkRange(entry.position, entry.position);
+
+		link* rest = head.next;
+		for (const auto& entry : selected)
+			linkRangeBefore(rest, entry.position, entry.position);
+		record(list_stats::counter::relinks, selected.size());
+		if (!selected.empty())
+			refreshFingerprint();
+	}
+
+	template<class Compare = std::less<>, class Projection = std::identity>
+	list extract_top_k(std::size_t k, Compare compare = {}, Projection projection = {})
+	{
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::remove_if);
+		const auto selected = smallest(k, compare, projection);
+		trace(list_stats::trace_op::remove_if, nelms, selected.size());
+
+		list result;
+		for (const auto& entry : selected)
+		{
+			unlinkRange(entry.position, entry.position);
+			linkRangeBefore(&result.head, entry.position, entry.position);
+		}
+		record(list_stats::counter::relinks, selected.size());
+		nelms -= selected.size();
+		result.nelms = selected.size();
+		if (!selected.empty())
+		{
+			refreshFingerprint();
+			result.refreshFingerprint();
+		}
+		return result;
+	}
+
+	template<class Compare = std::less<>, class Projection = std::identity>
+	[[nodiscard]] iterator select(std::size_t k, Compare compare = {}, Projection projection = {})
+	{
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::search);
+		return rankAll(k, compare, projection)[k].position;
+	}
+
+	template<class Compare = std::less<>, class Projection = std::identity>
+	iterator nth_element(std::size_t k, Compare compare = {}, Projection projection = {})
+	{
+		[[maybe_unused]] const auto timing = timeOperation(list_stats::operation::sort);
+		trace(list_stats::trace_op::sort, 0, nelms);
+
+		const auto all = rankAll(k, compare, projection);
+		const std::size_t pivotOrder = all[k].order;
+		std::vector<bool> before(nelms, false);
+		for (std::size_t i = 0; i < k; i++)
+			before[all[i].order] = true;
+
+		link lower;
+		link upper;
+		lower.next = lower.previous = &lower;
+		upper.next = upper.previous = &upper;
+		link* pivot = all[k].position;
+
+		std::size_t order = 0;
+		for (link* current = head.next; current != &head; ++order)
+		{
+			link* next = current->next;
+			if (order != pivotOrder)
+				linkRangeBefore(before[order] ? &lower : &upper, current, current);
+			current = next;
+		}
+
+		head.next = head.previous = &head;
+		if (lower.next != &lower)
+			linkRangeBefore(&head, lower.next, lower.previous);
+		linkRangeBefore(&head, pivot, pivot);
+		if (upper.next != &upper)
+			linkRangeBefore(&head, upper.next, upper.previous);
+		record(list_stats::counter::relinks, nelms);
+		refreshFingerprint();
+		return pivot;
+	}
+};
+
+namespace list_detail
+{
+	template<class T>
+	class node_handle
+	{
+	private:
+		node<T>* owned;
+
+		explicit node_handle(node<T>* owned_) : owned(owned_) {}
+
+	public:
+		template<class, class> friend class ::list;
+
+		node_handle() : owned(nullptr) {}
+		node_handle(const node_handle&) = delete;
+		node_handle(node_handle&& nh) noexcept : owned(std::exchange(nh.owned, nullptr)) {}
+
+		node_handle& operator=(const node_handle&) = delete;
+
+		node_handle& operator=(node_handle&& nh) noexcept
+		{
+			if (this != &nh)
+			{
+				delete owned;
+				owned = std::exchange(nh.owned, nullptr);
+			}
+			return *this;
+		}
+
+		~node_handle()
+		{
+			delete owned;
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return owned == nullptr;
+		}
+
+		explicit operator bool() const noexcept
+		{
+			return owned != nullptr;
+		}
+
+		T& value()
+		{
+			if (empty())
+				throw std::runtime_error("value called on empty node handle");
+			return owned->value;
+		}
+
+		const T& value() const
+		{
+			if (empty())
+				throw std::runtime_error("value called on empty node handle");
+			return owned->value;
+		}
+	};
+}
+
+template<class T, class Stats>
+struct std::hash<list<T, Stats>>
+{
+	std::size_t operator()(const list<T, Stats>& target) const
+	{
+		return std::size_t(target.fingerprint());
 	}
 };
\ No newline at end of file
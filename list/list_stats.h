@@ -0,0 +1,264 @@
+#pragma once
+
+#include<algorithm>
+#include<array>
+#include<bit>
+#include<chrono>
+#include<cstddef>
+#include<cstdint>
+#include<type_traits>
+
+namespace list_stats
+{
+	inline constexpr std::size_t cache_line = 64;
+
+	enum class counter
+	{
+		allocations,
+		deallocations,
+		nodes_walked,
+		comparisons,
+		relinks,
+		remove_if_visits
+	};
+
+	inline constexpr std::size_t counter_count = 6;
+
+	enum class operation
+	{
+		insert,
+		erase,
+		splice,
+		search,
+		sort,
+		remove_if
+	};
+
+	inline constexpr std::size_t operation_count = 6;
+
+	enum class trace_op : std::uint8_t
+	{
+		push_back,
+		push_front,
+		insert,
+		pop_back,
+		pop_front,
+		erase,
+		erase_range,
+		splice,
+		clear,
+		remove_if,
+		sort,
+		traverse
+	};
+
+	inline constexpr std::size_t trace_op_count = 12;
+
+	struct trace_event
+	{
+		trace_op op;
+		std::uint64_t index;
+		std::uint64_t count;
+		std::uint64_t value_bytes;
+
+		bool operator==(const trace_event&) const = default;
+	};
+
+	template<typename T>
+	std::uint64_t value_bytes(const T& value) noexcept
+	{
+		if constexpr (requires { value.size(); typename T::value_type; })
+			return sizeof(T) + std::uint64_t(value.size()) * sizeof(typename T::value_type);
+		else
+			return sizeof(T);
+	}
+
+	struct alignas(cache_line) latency_histogram
+	{
+		static constexpr std::size_t buckets = 40;
+
+		std::uint64_t calls = 0;
+		std::uint64_t total_ns = 0;
+		std::uint64_t max_ns = 0;
+		std::array<std::uint64_t, buckets> counts{};
+
+		static constexpr std::size_t bucket_of(std::uint64_t ns) noexcept
+		{
+			const std::size_t bucket = std::size_t(std::bit_width(ns));
+			return bucket < buckets ? bucket : buckets - 1;
+		}
+
+		void record(std::uint64_t ns) noexcept
+		{
+			++calls;
+			total_ns += ns;
+			max_ns = ns > max_ns ? ns : max_ns;
+			++counts[bucket_of(ns)];
+		}
+
+		[[nodiscard]] double mean_ns() const noexcept
+		{
+			return calls ? double(total_ns) / double(calls) : 0;
+		}
+
+		[[nodiscard]] std::uint64_t percentile_ns(double fraction) const noexcept
+		{
+			if (calls == 0)
+				return 0;
+			const auto wanted = std::uint64_t(fraction * double(calls - 1)) + 1;
+			std::uint64_t seen = 0;
+			for (std::size_t i = 0; i < buckets; i++)
+			{
+				seen += counts[i];
+				if (seen >= wanted)
+					return i == 0 ? 0 : std::min<std::uint64_t>((std::uint64_t(1) << i) - 1, max_ns);
+			}
+			return max_ns;
+		}
+	};
+
+	struct report
+	{
+		std::uint64_t allocations = 0;
+		std::uint64_t deallocations = 0;
+		std::uint64_t nodes_walked = 0;
+		std::uint64_t comparisons = 0;
+		std::uint64_t relinks = 0;
+		std::uint64_t remove_if_visits = 0;
+		std::array<latency_histogram, operation_count> latency{};
+
+		[[nodiscard]] const latency_histogram& latency_of(operation op) const noexcept
+		{
+			return latency[std::size_t(op)];
+		}
+	};
+
+	struct no_timer
+	{
+	};
+
+	struct disabled
+	{
+		static constexpr bool enabled = false;
+		static constexpr bool timed = false;
+		static constexpr bool traced = false;
+		static constexpr bool fingerprinted = false;
+		static constexpr bool maintained = false;
+	};
+
+	struct fingerprint
+	{
+		static constexpr bool enabled = false;
+		static constexpr bool timed = false;
+		static constexpr bool traced = false;
+		static constexpr bool fingerprinted = true;
+		static constexpr bool maintained = false;
+
+		std::uint64_t value = 0;
+	};
+
+	struct maintenance
+	{
+		static constexpr bool enabled = false;
+		static constexpr bool timed = false;
+		static constexpr bool traced = false;
+		static constexpr bool fingerprinted = false;
+		static constexpr bool maintained = true;
+
+		double defragment_threshold = 0;
+		std::size_t churn = 0;
+		std::uint64_t modifications = 0;
+	};
+
+	template<bool Timed>
+	class basic_counters
+	{
+	private:
+		struct alignas(cache_line) padded
+		{
+			std::uint64_t value = 0;
+		};
+
+		struct empty_latency
+		{
+		};
+
+		std::array<padded, counter_count> values{};
+		[[no_unique_address]] std::conditional_t<Timed, std::array<latency_histogram, operation_count>, empty_latency> histograms{};
+
+	public:
+		static constexpr bool enabled = true;
+		static constexpr bool timed = Timed;
+		static constexpr bool traced = false;
+		static constexpr bool fingerprinted = false;
+		static constexpr bool maintained = false;
+
+		class timer
+		{
+		private:
+			latency_histogram* target;
+			std::chrono::steady_clock::time_point start;
+
+		public:
+			explicit timer(latency_histogram& target_) : target(&target_), start(std::chrono::steady_clock::now()) {}
+			timer(const timer&) = delete;
+			timer& operator=(const timer&) = delete;
+
+			~timer()
+			{
+				const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+				target->record(std::uint64_t(elapsed.count()));
+			}
+		};
+
+		void add(counter which, std::uint64_t n = 1) noexcept
+		{
+			values[std::size_t(which)].value += n;
+		}
+
+		[[nodiscard]] timer time(operation op) noexcept
+			requires Timed
+		{
+			return timer(histograms[std::size_t(op)]);
+		}
+
+		[[nodiscard]] report snapshot() const noexcept
+		{
+			report result;
+			result.allocations = values[std::size_t(counter::allocations)].value;
+			result.deallocations = values[std::size_t(counter::deallocations)].value;
+			result.nodes_walked = values[std::size_t(counter::nodes_walked)].value;
+			result.comparisons = values[std::size_t(counter::comparisons)].value;
+			result.relinks = values[std::size_t(counter::relinks)].value;
+			result.remove_if_visits = values[std::size_t(counter::remove_if_visits)].value;
+			if constexpr (Timed)
+				result.latency = histograms;
+			return result;
+		}
+
+		void reset() noexcept
+		{
+			values = {};
+			if constexpr (Timed)
+				histograms = {};
+		}
+	};
+
+	using counters = basic_counters<false>;
+	using timed_counters = basic_counters<true>;
+
+	template<class... Policies>
+	struct combine : Policies...
+	{
+		static_assert((int(Policies::enabled) + ... + 0) <= 1, "combine takes at most one counting policy");
+		static_assert((int(Policies::traced) + ... + 0) <= 1, "combine takes at most one tracing policy");
+		static_assert((int(Policies::fingerprinted) + ... + 0) <= 1, "combine takes at most one fingerprint policy");
+		static_assert((int(Policies::maintained) + ... + 0) <= 1, "combine takes at most one maintenance policy");
+
+		static constexpr bool enabled = (Policies::enabled || ...);
+		static constexpr bool timed = (Policies::timed || ...);
+		static constexpr bool traced = (Policies::traced || ...);
+		static constexpr bool fingerprinted = (Policies::fingerprinted || ...);
+		static constexpr bool maintained = (Policies::maintained || ...);
+	};
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include<array>
+#include<cstddef>
+#include<cstdint>
+#include<istream>
+#include<ostream>
+#include<stdexcept>
+#include "list.h"
+#include "serialization.h"
+
+namespace list_trace
+{
+	inline constexpr std::array<char, 8> magic = { 'L', 'S', 'T', 'T', 'R', 'A', 'C', 'E' };
+	inline constexpr std::uint16_t version = 1;
+	inline constexpr std::uint8_t end_marker = 0xff;
+
+	using list_stats::trace_event;
+	using list_stats::trace_op;
+
+	class writer
+	{
+	private:
+		list_io::writer out;
+		std::uint64_t events;
+		bool closed;
+
+		void writeHeader()
+		{
+			out.write(magic.data(), magic.size());
+			out.write_raw(version);
+		}
+
+	public:
+		explicit writer(std::ostream& stream) : out(stream), events(0), closed(false)
+		{
+			writeHeader();
+		}
+
+		explicit writer(int fd) : out(fd), events(0), closed(false)
+		{
+			writeHeader();
+		}
+
+		writer(const writer&) = delete;
+		writer& operator=(const writer&) = delete;
+
+		~writer()
+		{
+			try
+			{
+				close();
+			}
+			catch (...)
+			{
+			}
+		}
+
+		void write(const trace_event& event)
+		{
+			if (closed)
+				throw std::runtime_error("write called on closed trace");
+			out.put(std::byte(event.op));
+			out.write_varint(event.index);
+			out.write_varint(event.count);
+			out.write_varint(event.value_bytes);
+			++events;
+		}
+
+		void close()
+		{
+			if (closed)
+				return;
+			closed = true;
+			out.put(std::byte(end_marker));
+			out.flush();
+		}
+
+		[[nodiscard]] std::uint64_t written() const noexcept
+		{
+			return events;
+		}
+	};
+
+	class reader
+	{
+	private:
+		list_io::reader in;
+
+	public:
+		explicit reader(std::istream& stream) : in(stream)
+		{
+			validate();
+		}
+
+		explicit reader(int fd) : in(fd)
+		{
+			validate();
+		}
+
+		void validate()
+		{
+			std::array<char, magic.size()> found;
+			in.read(found.data(), found.size());
+			if (found != magic)
+				throw std::runtime_error("not a list trace");
+			if (in.read_raw<std::uint16_t>() != version)
+				throw std::runtime_error("unsupported list trace version");
+		}
+
+		bool next(trace_event& event)
+		{
+			const auto op = std::to_integer<std::uint8_t>(in.get());
+			if (op == end_marker)
+				return false;
+			if (op >= list_stats::trace_op_count)
+				throw std::runtime_error("invalid operation in list trace");
+			event.op = trace_op(op);
+			event.index = in.read_varint();
+			event.count = in.read_varint();
+			event.value_bytes = in.read_varint();
+			return true;
+		}
+	};
+
+	class recording
+	{
+	private:
+		writer* sink = nullptr;
+
+	public:
+		static constexpr bool enabled = false;
+		static constexpr bool timed = false;
+		static constexpr bool traced = true;
+		static constexpr bool fingerprinted = false;
+		static constexpr bool maintained = false;
+
+		void attach(writer& target) noexcept
+		{
+			sink = &target;
+		}
+
+		void detach() noexcept
+		{
+			sink = nullptr;
+		}
+
+		[[nodiscard]] bool attached() const noexcept
+		{
+			return sink != nullptr;
+		}
+
+		void emit(const trace_event& event)
+		{
+			if (sink)
+				sink->write(event);
+		}
+	};
+
+	template<typename T>
+	using recorded_list = list<T, recording>;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include<cstdint>
+
+struct offset_link
+{
+	std::int64_t next = 0;
+	std::int64_t previous = 0;
+
+	static std::int64_t distance(const offset_link* from, const offset_link* to) noexcept
+	{
+		return static_cast<std::int64_t>(reinterpret_cast<std::intptr_t>(to) - reinterpret_cast<std::intptr_t>(from));
+	}
+
+	offset_link* next_link() const noexcept
+	{
+		return at(next);
+	}
+
+	offset_link* previous_link() const noexcept
+	{
+		return at(previous);
+	}
+
+	void set_next(const offset_link* target) noexcept
+	{
+		next = distance(this, target);
+	}
+
+	void set_previous(const offset_link* target) noexcept
+	{
+		previous = distance(this, target);
+	}
+
+	void reset() noexcept
+	{
+		next = 0;
+		previous = 0;
+	}
+
+private:
+	offset_link* at(std::int64_t offset) const noexcept
+	{
+		return reinterpret_cast<offset_link*>(reinterpret_cast<std::intptr_t>(this) + offset);
+	}
+};
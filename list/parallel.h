@@ -0,0 +1,228 @@
+#pragma once
+
+#include<algorithm>
+#include<atomic>
+#include<concepts>
+#include<condition_variable>
+#include<cstddef>
+#include<cstdint>
+#include<exception>
+#include<memory>
+#include<mutex>
+#include<thread>
+#include<type_traits>
+#include<utility>
+#include<vector>
+
+namespace list_parallel
+{
+	inline constexpr std::size_t min_chunk = 4096;
+	inline constexpr std::size_t max_parts = 256;
+
+	[[nodiscard]] inline std::size_t parts_for(std::size_t elements) noexcept
+	{
+		return std::clamp<std::size_t>(elements / min_chunk, 1, max_parts);
+	}
+
+	class thread_pool
+	{
+	private:
+		static constexpr std::size_t no_task = ~std::size_t(0);
+
+		struct job
+		{
+			void* context = nullptr;
+			void (*invoke)(void*, std::size_t) = nullptr;
+			std::size_t tasks = 0;
+			std::atomic<std::size_t> next{ 0 };
+			std::size_t finished = 0;
+			std::size_t attached = 0;
+			std::exception_ptr error = nullptr;
+			std::size_t errorTask = no_task;
+		};
+
+		std::vector<std::thread> workers;
+		std::mutex submit;
+		std::mutex guard;
+		std::condition_variable wake;
+		std::condition_variable idle;
+		job* current = nullptr;
+		std::uint64_t generation = 0;
+		bool stopping = false;
+
+		static inline thread_local const thread_pool* owner = nullptr;
+
+		void work(job& target)
+		{
+			std::size_t completed = 0;
+			for (;;)
+			{
+				const std::size_t task = target.next.fetch_add(1, std::memory_order_relaxed);
+				if (task >= target.tasks)
+					break;
+				try
+				{
+					target.invoke(target.context, task);
+				}
+				catch (...)
+				{
+					std::lock_guard lock(guard);
+					if (task < target.errorTask)
+					{
+						target.error = std::current_exception();
+						target.errorTask = task;
+					}
+				}
+				++completed;
+			}
+
+			std::lock_guard lock(guard);
+			target.finished += completed;
+			if (target.finished == target.tasks)
+				idle.notify_all();
+		}
+
+		void loop()
+		{
+			owner = this;
+			std::uint64_t seen = 0;
+			for (;;)
+			{
+				job* target;
+				{
+					std::unique_lock lock(guard);
+					wake.wait(lock, [&] { return stopping || (current && generation != seen); });
+					if (stopping)
+						return;
+					seen = generation;
+					target = current;
+					++target->attached;
+				}
+
+				work(*target);
+
+				std::lock_guard lock(guard);
+				--target->attached;
+				idle.notify_all();
+			}
+		}
+
+	public:
+		explicit thread_pool(std::size_t threads = std::max(1u, std::thread::hardware_concurrency()) - 1)
+		{
+			workers.reserve(threads);
+			for (std::size_t i = 0; i < threads; i++)
+				workers.emplace_back([this] { loop(); });
+		}
+
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator=(const thread_pool&) = delete;
+
+		~thread_pool()
+		{
+			{
+				std::lock_guard lock(guard);
+				stopping = true;
+			}
+			wake.notify_all();
+			for (std::thread& worker : workers)
+				worker.join();
+		}
+
+		static thread_pool& shared()
+		{
+			static thread_pool pool;
+			return pool;
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return workers.size() + 1;
+		}
+
+		template<class Task>
+		void run(std::size_t tasks, Task&& task)
+		{
+			if (tasks == 0)
+				return;
+			if (workers.empty() || tasks == 1 || owner == this)
+			{
+				for (std::size_t i = 0; i < tasks; i++)
+					task(i);
+				return;
+			}
+
+			std::lock_guard serial(submit);
+			job target{ const_cast<void*>(static_cast<const void*>(std::addressof(task))),
+				[](void* context, std::size_t i) { (*static_cast<std::remove_reference_t<Task>*>(context))(i); }, tasks };
+			{
+				std::lock_guard lock(guard);
+				current = &target;
+				++generation;
+			}
+			wake.notify_all();
+
+			const thread_pool* caller = std::exchange(owner, this);
+			work(target);
+			owner = caller;
+
+			{
+				std::unique_lock lock(guard);
+				idle.wait(lock, [&] { return target.finished == target.tasks && target.attached == 0; });
+				current = nullptr;
+			}
+
+			if (target.error)
+				std::rethrow_exception(target.error);
+		}
+	};
+
+	struct sequenced_policy
+	{
+	};
+
+	struct parallel_policy
+	{
+	};
+
+	inline constexpr sequenced_policy seq{};
+	inline constexpr parallel_policy par{};
+
+	template<class Policy>
+	struct policy_traits
+	{
+		static constexpr bool is_policy = false;
+		static constexpr bool parallel = false;
+	};
+
+	template<>
+	struct policy_traits<sequenced_policy>
+	{
+		static constexpr bool is_policy = true;
+		static constexpr bool parallel = false;
+	};
+
+	template<>
+	struct policy_traits<parallel_policy>
+	{
+		static constexpr bool is_policy = true;
+		static constexpr bool parallel = true;
+	};
+
+	template<class Executor>
+	concept executor = std::same_as<std::remove_cvref_t<Executor>, thread_pool>
+		|| policy_traits<std::remove_cvref_t<Executor>>::is_policy;
+
+	template<executor Executor, class Task>
+	void run(Executor&& where, std::size_t tasks, Task&& task)
+	{
+		using plain = std::remove_cvref_t<Executor>;
+		if constexpr (std::same_as<plain, thread_pool>)
+			where.run(tasks, task);
+		else if constexpr (policy_traits<plain>::parallel)
+			thread_pool::shared().run(tasks, task);
+		else
+			for (std::size_t i = 0; i < tasks; i++)
+				task(i);
+	}
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include<execution>
+#include<type_traits>
+#include "parallel.h"
+
+namespace list_parallel
+{
+	template<class Policy>
+		requires std::is_execution_policy_v<Policy>
+	struct policy_traits<Policy>
+	{
+		static constexpr bool is_policy = true;
+		static constexpr bool parallel = !std::is_same_v<Policy, std::execution::sequenced_policy>;
+	};
+}
@@ -0,0 +1,631 @@
+#pragma once
+
+#include<algorithm>
+#include<array>
+#include<atomic>
+#include<cerrno>
+#include<cstddef>
+#include<cstdint>
+#include<functional>
+#include<iterator>
+#include<new>
+#include<stdexcept>
+#include<string>
+#include<system_error>
+#include<type_traits>
+#include<utility>
+#include<vector>
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#include "offset_link.h"
+
+template<class T>
+	requires std::is_trivially_copyable_v<T>
+class persistent_list
+{
+public:
+	enum class durability
+	{
+		checkpoint,
+		ordered
+	};
+
+private:
+	struct node : public offset_link
+	{
+		T value;
+	};
+
+	struct header
+	{
+		std::array<char, 8> magic;
+		std::uint32_t version;
+		std::uint32_t valueSize;
+		std::uint32_t valueAlign;
+		std::uint32_t clean;
+		std::uint64_t capacity;
+		std::uint64_t highWater;
+		std::uint64_t size;
+		std::uint64_t freeHead;
+		offset_link head;
+	};
+
+	static constexpr std::array<char, 8> file_magic = { 'L', 'S', 'T', 'P', 'M', 'A', 'P', '\0' };
+	static constexpr std::uint32_t file_version = 1;
+	static constexpr std::uint64_t no_slot = ~std::uint64_t(0);
+	static constexpr std::size_t nodes_offset = (sizeof(header) + alignof(node) - 1) / alignof(node) * alignof(node);
+	static constexpr std::size_t initial_bytes = std::size_t(1) << 16;
+
+	int fd;
+	std::byte* base;
+	std::size_t mappedBytes;
+	durability mode;
+	bool recoveredOnOpen;
+
+	[[noreturn]] static void fail(const char* what)
+	{
+		throw std::system_error(errno, std::generic_category(), what);
+	}
+
+	header& meta() const noexcept
+	{
+		return *reinterpret_cast<header*>(base);
+	}
+
+	offset_link* sentinel() const noexcept
+	{
+		return &meta().head;
+	}
+
+	node* slot(std::uint64_t index) const noexcept
+	{
+		return reinterpret_cast<node*>(base + nodes_offset + index * sizeof(node));
+	}
+
+	std::size_t byteOffset(const offset_link* target) const noexcept
+	{
+		return static_cast<std::size_t>(reinterpret_cast<const std::byte*>(target) - base);
+	}
+
+	offset_link* linkAt(std::size_t offset) const noexcept
+	{
+		return reinterpret_cast<offset_link*>(base + offset);
+	}
+
+	std::uint64_t checkedIndex(const offset_link* target) const
+	{
+		const auto offset = reinterpret_cast<std::intptr_t>(target) - reinterpret_cast<std::intptr_t>(base);
+		if (offset < std::intptr_t(nodes_offset) || (offset - std::intptr_t(nodes_offset)) % std::intptr_t(sizeof(node)) != 0)
+			throw std::runtime_error("persistent_list file is corrupt");
+		const auto index = std::uint64_t(offset - std::intptr_t(nodes_offset)) / sizeof(node);
+		if (index >= meta().highWater)
+			throw std::runtime_error("persistent_list file is corrupt");
+		return index;
+	}
+
+	void map(std::size_t bytes)
+	{
+		void* mapped = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (mapped == MAP_FAILED)
+			fail("mmap");
+		base = static_cast<std::byte*>(mapped);
+		mappedBytes = bytes;
+	}
+
+	void unmap() noexcept
+	{
+		if (base)
+			::munmap(base, mappedBytes);
+		base = nullptr;
+		mappedBytes = 0;
+	}
+
+	void syncRange(const void* from, std::size_t n) const
+	{
+		const auto page = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+		const auto first = reinterpret_cast<std::uintptr_t>(from) & ~(page - 1);
+		const auto last = reinterpret_cast<std::uintptr_t>(from) + n;
+		if (::msync(reinterpret_cast<void*>(first), last - first, MS_SYNC) != 0)
+			fail("msync");
+	}
+
+	void markDirty()
+	{
+		if (meta().clean)
+		{
+			meta().clean = 0;
+			syncRange(base, sizeof(header));
+		}
+	}
+
+	void create()
+	{
+		const std::size_t bytes = std::max(initial_bytes, nodes_offset + sizeof(node));
+		if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+			fail("ftruncate");
+		map(bytes);
+
+		header* fresh = ::new (static_cast<void*>(base)) header{};
+		fresh->magic = file_magic;
+		fresh->version = file_version;
+		fresh->valueSize = sizeof(T);
+		fresh->valueAlign = alignof(T);
+		fresh->capacity = (bytes - nodes_offset) / sizeof(node);
+		fresh->freeHead = no_slot;
+		fresh->clean = 1;
+		syncRange(base, bytes);
+	}
+
+	void attach(std::size_t bytes)
+	{
+		if (bytes < nodes_offset)
+			throw std::runtime_error("persistent_list file format mismatch");
+		map(bytes);
+
+		const header& h = meta();
+		if (h.magic != file_magic || h.version != file_version || h.valueSize != sizeof(T) || h.valueAlign != alignof(T))
+			throw std::runtime_error("persistent_list file format mismatch");
+		if (nodes_offset + h.capacity * sizeof(node) > bytes || h.highWater > h.capacity)
+			throw std::runtime_error("persistent_list file is corrupt");
+
+		if (!h.clean)
+			recover();
+	}
+
+	void recover()
+	{
+		header& h = meta();
+		std::vector<bool> reachable(h.highWater);
+		std::uint64_t count = 0;
+
+		offset_link* previous = sentinel();
+		for (offset_link* current = previous->next_link(); current != sentinel(); current = current->next_link())
+		{
+			const std::uint64_t index = checkedIndex(current);
+			if (reachable[index])
+				throw std::runtime_error("persistent_list file is corrupt");
+			reachable[index] = true;
+			++count;
+			current->set_previous(previous);
+			previous = current;
+		}
+		sentinel()->set_previous(previous);
+
+		h.size = count;
+		h.freeHead = no_slot;
+		for (std::uint64_t i = h.highWater; i-- > 0;)
+			if (!reachable[i])
+				release(slot(i));
+
+		recoveredOnOpen = true;
+		checkpoint();
+	}
+
+	void grow(std::uint64_t minimum)
+	{
+		std::uint64_t capacity = meta().capacity;
+		while (capacity < minimum)
+			capacity *= 2;
+
+		const std::size_t bytes = nodes_offset + capacity * sizeof(node);
+		if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+			fail("ftruncate");
+		unmap();
+		map(bytes);
+		meta().capacity = capacity;
+	}
+
+	node* allocate()
+	{
+		header& h = meta();
+		if (h.freeHead != no_slot)
+		{
+			node* target = slot(h.freeHead);
+			h.freeHead = static_cast<std::uint64_t>(target->next);
+			return target;
+		}
+		if (h.highWater == h.capacity)
+			grow(h.capacity + 1);
+		return slot(meta().highWater++);
+	}
+
+	void release(node* target) noexcept
+	{
+		header& h = meta();
+		target->next = static_cast<std::int64_t>(h.freeHead);
+		h.freeHead = static_cast<std::uint64_t>(reinterpret_cast<std::byte*>(target) - (base + nodes_offset)) / sizeof(node);
+	}
+
+	template<typename... Args>
+	node* emplaceBefore(std::size_t whereOffset, Args&&... args)
+	{
+		T value(std::forward<Args>(args)...);
+		markDirty();
+		const std::uint64_t watermark = meta().highWater;
+		node* newnode = allocate();
+		::new (static_cast<void*>(&newnode->value)) T(value);
+
+		offset_link* where = linkAt(whereOffset);
+		offset_link* before = where->previous_link();
+		newnode->set_next(where);
+		newnode->set_previous(before);
+		if (mode == durability::ordered)
+		{
+			syncRange(newnode, sizeof(node));
+			if (meta().highWater != watermark)
+				syncRange(base, sizeof(header));
+		}
+
+		std::atomic_signal_fence(std::memory_order_release);
+		before->set_next(newnode);
+		where->set_previous(newnode);
+		++meta().size;
+		return newnode;
+	}
+
+	offset_link* unlink(offset_link* target)
+	{
+		markDirty();
+		offset_link* before = target->previous_link();
+		offset_link* after = target->next_link();
+		before->set_next(after);
+		after->set_previous(before);
+		if (mode == durability::ordered)
+			syncRange(before, sizeof(offset_link));
+
+		--meta().size;
+		release(static_cast<node*>(target));
+		if (mode == durability::ordered)
+		{
+			syncRange(target, sizeof(offset_link));
+			syncRange(base, sizeof(header));
+		}
+		return after;
+	}
+
+	template<bool Const>
+	class basic_iterator
+	{
+	private:
+		offset_link* linker;
+		const offset_link* head;
+
+	public:
+		friend class persistent_list;
+		template<bool> friend class basic_iterator;
+
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, const T*, T*>;
+		using reference = std::conditional_t<Const, const T&, T&>;
+
+		basic_iterator() : linker(nullptr), head(nullptr) {}
+		basic_iterator(const offset_link* linker_, const offset_link* head_) : linker(const_cast<offset_link*>(linker_)), head(head_) {}
+
+		template<bool OtherConst>
+			requires (Const || !OtherConst)
+		basic_iterator(const basic_iterator<OtherConst>& it) : linker(it.linker), head(it.head) {}
+
+		basic_iterator& operator++()
+		{
+			linker = linker->next_link();
+			return *this;
+		}
+
+		basic_iterator operator++(int)
+		{
+			auto aux = *this;
+			++(*this);
+			return aux;
+		}
+
+		basic_iterator& operator--()
+		{
+			linker = linker->previous_link();
+			return *this;
+		}
+
+		basic_iterator operator--(int)
+		{
+			auto aux = *this;
+			--(*this);
+			return aux;
+		}
+
+		reference operator*() const
+		{
+			if (linker == head)
+				throw std::runtime_error("Invalid ptr to use '*' ");
+			return static_cast<node*>(linker)->value;
+		}
+
+		pointer operator->() const
+		{
+			return &**this;
+		}
+
+		template<bool OtherConst>
+		bool operator==(const basic_iterator<OtherConst>& it) const noexcept
+		{
+			return linker == it.linker;
+		}
+	};
+
+public:
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
+	explicit persistent_list(const std::string& path, durability mode_ = durability::checkpoint)
+		: fd(-1), base(nullptr), mappedBytes(0), mode(mode_), recoveredOnOpen(false)
+	{
+		fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+		if (fd < 0)
+			fail("open");
+
+		try
+		{
+			struct stat status;
+			if (::fstat(fd, &status) != 0)
+				fail("fstat");
+			if (status.st_size == 0)
+				create();
+			else
+				attach(static_cast<std::size_t>(status.st_size));
+		}
+		catch (...)
+		{
+			unmap();
+			::close(fd);
+			throw;
+		}
+	}
+
+	persistent_list(const persistent_list&) = delete;
+	persistent_list& operator=(const persistent_list&) = delete;
+
+	persistent_list(persistent_list&& other) noexcept
+		: fd(std::exchange(other.fd, -1)),
+		base(std::exchange(other.base, nullptr)),
+		mappedBytes(std::exchange(other.mappedBytes, 0)),
+		mode(other.mode),
+		recoveredOnOpen(other.recoveredOnOpen) {}
+
+	~persistent_list()
+	{
+		if (base)
+		{
+			try
+			{
+				checkpoint();
+			}
+			catch (...)
+			{
+			}
+		}
+		unmap();
+		if (fd >= 0)
+			::close(fd);
+	}
+
+	void checkpoint()
+	{
+		syncRange(base, mappedBytes);
+		if (!meta().clean)
+		{
+			meta().clean = 1;
+			syncRange(base, sizeof(header));
+		}
+	}
+
+	[[nodiscard]] bool recovered() const noexcept
+	{
+		return recoveredOnOpen;
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept
+	{
+		return static_cast<std::size_t>(meta().size);
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return meta().size == 0;
+	}
+
+	[[nodiscard]] std::size_t capacity() const noexcept
+	{
+		return static_cast<std::size_t>(meta().capacity);
+	}
+
+	void reserve(std::size_t n)
+	{
+		if (n > meta().capacity)
+			grow(n);
+	}
+
+	template <typename... Args>
+	void emplace_back(Args &&...args)
+	{
+		emplaceBefore(byteOffset(sentinel()), std::forward<Args>(args)...);
+	}
+
+	void push_back(const T& newvalue)
+	{
+		emplace_back(newvalue);
+	}
+
+	template <typename... Args>
+	void emplace_front(Args &&...args)
+	{
+		emplaceBefore(byteOffset(sentinel()->next_link()), std::forward<Args>(args)...);
+	}
+
+	void push_front(const T& newvalue)
+	{
+		emplace_front(newvalue);
+	}
+
+	void pop_back()
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		unlink(sentinel()->previous_link());
+	}
+
+	void pop_front()
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		unlink(sentinel()->next_link());
+	}
+
+	T& front()
+	{
+		if (empty())
+			throw std::length_error("front called on empty list");
+		return static_cast<node*>(sentinel()->next_link())->value;
+	}
+
+	T& back()
+	{
+		if (empty())
+			throw std::length_error("back called on empty list");
+		return static_cast<node*>(sentinel()->previous_link())->value;
+	}
+
+	const T& front() const
+	{
+		if (empty())
+			throw std::length_error("front called on empty list");
+		return static_cast<const node*>(sentinel()->next_link())->value;
+	}
+
+	const T& back() const
+	{
+		if (empty())
+			throw std::length_error("back called on empty list");
+		return static_cast<const node*>(sentinel()->previous_link())->value;
+	}
+
+	void clear()
+	{
+		markDirty();
+		header& h = meta();
+		h.head.reset();
+		h.size = 0;
+		h.highWater = 0;
+		h.freeHead = no_slot;
+		if (mode == durability::ordered)
+			syncRange(base, sizeof(header));
+	}
+
+	[[nodiscard]] iterator begin() noexcept { return { sentinel()->next_link(), sentinel() }; }
+	[[nodiscard]] iterator end() noexcept { return { sentinel(), sentinel() }; }
+	[[nodiscard]] const_iterator begin() const noexcept { return { sentinel()->next_link(), sentinel() }; }
+	[[nodiscard]] const_iterator end() const noexcept { return { sentinel(), sentinel() }; }
+	[[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+	[[nodiscard]] const_iterator cend() const noexcept { return end(); }
+
+	template<typename It, typename ...Args>
+		requires std::same_as<It, iterator> || std::same_as<It, const_iterator>
+	It emplace(It it, Args&& ... args)
+	{
+		node* newnode = emplaceBefore(byteOffset(it.linker), std::forward<Args>(args)...);
+		return It(newnode, sentinel());
+	}
+
+	template<typename It>
+		requires std::same_as<It, iterator> || std::same_as<It, const_iterator>
+	It insert(It it, const T& newvalue)
+	{
+		return emplace<It>(it, newvalue);
+	}
+
+	template<typename It>
+		requires std::same_as<It, iterator> || std::same_as<It, const_iterator>
+	It pop(It it)
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		if (it.linker == sentinel())
+			throw std::runtime_error("pop called on head");
+		return It(unlink(it.linker), sentinel());
+	}
+
+	template<typename It>
+		requires std::same_as<It, iterator> || std::same_as<It, const_iterator>
+	It erase(It first, It last)
+	{
+		for (offset_link* current = first.linker; current != last.linker; current = current->next_link())
+			if (current == sentinel())
+				throw std::runtime_error("erase range contains head");
+
+		offset_link* current = first.linker;
+		while (current != last.linker)
+			current = unlink(current);
+		return last;
+	}
+
+	template<class Function>
+	Function for_each(Function function)
+	{
+		for (offset_link* current = sentinel()->next_link(); current != sentinel(); current = current->next_link())
+			function(static_cast<node*>(current)->value);
+		return function;
+	}
+
+	template<class Function>
+	Function for_each(Function function) const
+	{
+		const_cast<persistent_list*>(this)->for_each([&](T& value) { function(std::as_const(value)); });
+		return function;
+	}
+
+	template<class Condition>
+	[[nodiscard]] iterator find_if(Condition condition)
+	{
+		offset_link* current = sentinel()->next_link();
+		while (current != sentinel() && !condition(std::as_const(static_cast<node*>(current)->value)))
+			current = current->next_link();
+		return { current, sentinel() };
+	}
+
+	template<class Condition>
+	[[nodiscard]] const_iterator find_if(Condition condition) const
+	{
+		return const_cast<persistent_list*>(this)->find_if(condition);
+	}
+
+	[[nodiscard]] iterator find(const T& target)
+	{
+		return find_if([&](const T& value) { return value == target; });
+	}
+
+	[[nodiscard]] const_iterator find(const T& target) const
+	{
+		return find_if([&](const T& value) { return value == target; });
+	}
+
+	[[nodiscard]] bool contains(const T& target) const
+	{
+		return find(target) != cend();
+	}
+
+	template<class Condition>
+	[[nodiscard]] std::size_t count_if(Condition condition) const
+	{
+		std::size_t total = 0;
+		for_each([&](const T& value) { total += bool(condition(value)); });
+		return total;
+	}
+
+	template<typename U, class BinaryOperation = std::plus<>>
+	[[nodiscard]] U accumulate(U init, BinaryOperation operation = {}) const
+	{
+		for_each([&](const T& value) { init = operation(std::move(init), value); });
+		return init;
+	}
+};
@@ -0,0 +1,429 @@
+#pragma once
+
+#include<algorithm>
+#include<array>
+#include<bit>
+#include<cerrno>
+#include<concepts>
+#include<cstddef>
+#include<cstdint>
+#include<cstring>
+#include<istream>
+#include<ostream>
+#include<stdexcept>
+#include<string>
+#include<type_traits>
+#include<vector>
+#include "list.h"
+
+#if defined(_WIN32)
+#include<io.h>
+#else
+#include<unistd.h>
+#endif
+
+namespace list_io
+{
+	inline constexpr std::array<char, 4> magic = { 'L', 'S', 'T', 'B' };
+	inline constexpr std::uint16_t version = 1;
+	inline constexpr std::uint16_t byte_order = 0x0102;
+	inline constexpr std::size_t buffer_bytes = std::size_t(1) << 16;
+
+	enum class encoding : std::uint8_t
+	{
+		raw = 0,
+		delta_varint = 1,
+		custom = 2
+	};
+
+	class writer;
+	class reader;
+
+	template<typename T>
+	struct serializer;
+
+	template<typename T>
+	concept custom_serializable = requires(writer & out, reader & in, const T & value)
+	{
+		serializer<T>::write(out, value);
+		{ serializer<T>::read(in) } -> std::convertible_to<T>;
+	};
+
+	template<typename T>
+	concept delta_encodable = std::integral<T> && !std::same_as<T, bool> && sizeof(T) <= sizeof(std::uint64_t);
+
+	template<typename T>
+	constexpr encoding encoding_of() noexcept
+	{
+		if constexpr (custom_serializable<T>)
+			return encoding::custom;
+		else if constexpr (delta_encodable<T>)
+			return encoding::delta_varint;
+		else
+			return encoding::raw;
+	}
+
+	class writer
+	{
+	private:
+		std::ostream* stream;
+		int fd;
+		std::vector<std::byte> buffer;
+		std::size_t used;
+
+		void drain(const std::byte* data, std::size_t n)
+		{
+			if (stream)
+			{
+				if (!stream->write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(n)))
+					throw std::runtime_error("failed to write list data");
+				return;
+			}
+
+			while (n > 0)
+			{
+#if defined(_WIN32)
+				const auto written = ::_write(fd, data, static_cast<unsigned>(std::min<std::size_t>(n, 1u << 30)));
+#else
+				const auto written = ::write(fd, data, n);
+#endif
+				if (written < 0 && errno == EINTR)
+					continue;
+				if (written <= 0)
+					throw std::runtime_error("failed to write list data");
+				data += written;
+				n -= static_cast<std::size_t>(written);
+			}
+		}
+
+	public:
+		explicit writer(std::ostream& out, std::size_t bufferBytes = buffer_bytes)
+			: stream(&out), fd(-1), buffer(std::max<std::size_t>(bufferBytes, 1)), used(0) {}
+		explicit writer(int fd_, std::size_t bufferBytes = buffer_bytes)
+			: stream(nullptr), fd(fd_), buffer(std::max<std::size_t>(bufferBytes, 1)), used(0) {}
+
+		writer(const writer&) = delete;
+		writer& operator=(const writer&) = delete;
+
+		void write(const void* data, std::size_t n)
+		{
+			const std::byte* bytes = static_cast<const std::byte*>(data);
+			if (used + n > buffer.size())
+			{
+				flush();
+				if (n >= buffer.size())
+				{
+					drain(bytes, n);
+					return;
+				}
+			}
+			std::memcpy(buffer.data() + used, bytes, n);
+			used += n;
+		}
+
+		void put(std::byte value)
+		{
+			if (used == buffer.size())
+				flush();
+			buffer[used++] = value;
+		}
+
+		template<typename U>
+			requires std::is_trivially_copyable_v<U>
+		void write_raw(const U& value)
+		{
+			write(&value, sizeof(U));
+		}
+
+		void write_varint(std::uint64_t value)
+		{
+			while (value >= 0x80)
+			{
+				put(std::byte((value & 0x7f) | 0x80));
+				value >>= 7;
+			}
+			put(std::byte(value));
+		}
+
+		void flush()
+		{
+			if (used > 0)
+				drain(buffer.data(), used);
+			used = 0;
+			if (stream && !stream->flush())
+				throw std::runtime_error("failed to write list data");
+		}
+	};
+
+	class reader
+	{
+	private:
+		std::istream* stream;
+		int fd;
+		std::vector<std::byte> buffer;
+		std::size_t position;
+		std::size_t filled;
+
+		std::size_t fill(std::byte* data, std::size_t n)
+		{
+			if (stream)
+			{
+				stream->read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(n));
+				return static_cast<std::size_t>(stream->gcount());
+			}
+
+			for (;;)
+			{
+#if defined(_WIN32)
+				const auto got = ::_read(fd, data, static_cast<unsigned>(std::min<std::size_t>(n, 1u << 30)));
+#else
+				const auto got = ::read(fd, data, n);
+#endif
+				if (got < 0 && errno == EINTR)
+					continue;
+				if (got < 0)
+					throw std::runtime_error("failed to read list data");
+				return static_cast<std::size_t>(got);
+			}
+		}
+
+		void refill()
+		{
+			position = 0;
+			filled = fill(buffer.data(), buffer.size());
+			if (filled == 0)
+				throw std::runtime_error("unexpected end of list data");
+		}
+
+	public:
+		explicit reader(std::istream& in, std::size_t bufferBytes = buffer_bytes)
+			: stream(&in), fd(-1), buffer(std::max<std::size_t>(bufferBytes, 1)), position(0), filled(0) {}
+		explicit reader(int fd_, std::size_t bufferBytes = buffer_bytes)
+			: stream(nullptr), fd(fd_), buffer(std::max<std::size_t>(bufferBytes, 1)), position(0), filled(0) {}
+
+		reader(const reader&) = delete;
+		reader& operator=(const reader&) = delete;
+
+		~reader()
+		{
+			const auto unread = static_cast<long long>(filled - position);
+			if (unread == 0)
+				return;
+
+			if (stream)
+			{
+				stream->clear();
+				stream->seekg(-unread, std::ios_base::cur);
+			}
+			else
+			{
+#if defined(_WIN32)
+				::_lseeki64(fd, -unread, SEEK_CUR);
+#else
+				::lseek(fd, static_cast<off_t>(-unread), SEEK_CUR);
+#endif
+			}
+		}
+
+		void read(void* data, std::size_t n)
+		{
+			std::byte* bytes = static_cast<std::byte*>(data);
+			while (n > 0)
+			{
+				if (position == filled)
+				{
+					if (n >= buffer.size())
+					{
+						const std::size_t got = fill(bytes, n);
+						if (got == 0)
+							throw std::runtime_error("unexpected end of list data");
+						bytes += got;
+						n -= got;
+						continue;
+					}
+					refill();
+				}
+
+				const std::size_t chunk = std::min(n, filled - position);
+				std::memcpy(bytes, buffer.data() + position, chunk);
+				position += chunk;
+				bytes += chunk;
+				n -= chunk;
+			}
+		}
+
+		std::byte get()
+		{
+			if (position == filled)
+				refill();
+			return buffer[position++];
+		}
+
+		template<typename U>
+			requires std::is_trivially_copyable_v<U>
+		U read_raw()
+		{
+			std::array<std::byte, sizeof(U)> bytes;
+			read(bytes.data(), sizeof(U));
+			return std::bit_cast<U>(bytes);
+		}
+
+		std::uint64_t read_varint()
+		{
+			std::uint64_t value = 0;
+			for (unsigned shift = 0; shift < 64; shift += 7)
+			{
+				const auto byte = std::to_integer<std::uint64_t>(get());
+				value |= (byte & 0x7f) << shift;
+				if (!(byte & 0x80))
+					return value;
+			}
+			throw std::runtime_error("invalid varint in list data");
+		}
+	};
+
+	template<typename CharT, typename Traits, typename Allocator>
+	struct serializer<std::basic_string<CharT, Traits, Allocator>>
+	{
+		using string = std::basic_string<CharT, Traits, Allocator>;
+
+		static void write(writer& out, const string& value)
+		{
+			out.write_varint(value.size());
+			out.write(value.data(), value.size() * sizeof(CharT));
+		}
+
+		static string read(reader& in)
+		{
+			string value(static_cast<std::size_t>(in.read_varint()), CharT{});
+			in.read(value.data(), value.size() * sizeof(CharT));
+			return value;
+		}
+	};
+
+	template<typename T>
+	class codec
+	{
+	private:
+		std::uint64_t previous = 0;
+
+	public:
+		static constexpr encoding kind = encoding_of<T>();
+		static_assert(kind != encoding::raw || std::is_trivially_copyable_v<T>,
+			"list_io needs a trivially copyable T or a list_io::serializer<T> specialization");
+
+		void encode(writer& out, const T& value)
+		{
+			if constexpr (kind == encoding::custom)
+			{
+				serializer<T>::write(out, value);
+			}
+			else if constexpr (kind == encoding::delta_varint)
+			{
+				const auto current = static_cast<std::uint64_t>(value);
+				const auto delta = static_cast<std::int64_t>(current - previous);
+				out.write_varint((static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63));
+				previous = current;
+			}
+			else
+			{
+				out.write_raw(value);
+			}
+		}
+
+		T decode(reader& in)
+		{
+			if constexpr (kind == encoding::custom)
+			{
+				return T(serializer<T>::read(in));
+			}
+			else if constexpr (kind == encoding::delta_varint)
+			{
+				const std::uint64_t zigzag = in.read_varint();
+				previous += (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+				return static_cast<T>(previous);
+			}
+			else
+			{
+				return in.read_raw<T>();
+			}
+		}
+	};
+
+	template<typename T>
+	void write_header(writer& out, std::uint64_t count)
+	{
+		out.write(magic.data(), magic.size());
+		out.write_raw(version);
+		out.write_raw(byte_order);
+		out.write_raw(codec<T>::kind);
+		out.write_raw(static_cast<std::uint32_t>(sizeof(T)));
+		out.write_raw(count);
+	}
+
+	template<typename T>
+	std::uint64_t read_header(reader& in)
+	{
+		std::array<char, 4> header;
+		in.read(header.data(), header.size());
+		if (header != magic)
+			throw std::runtime_error("invalid list data");
+		if (in.read_raw<std::uint16_t>() != version)
+			throw std::runtime_error("unsupported list data version");
+		if (in.read_raw<std::uint16_t>() != byte_order)
+			throw std::runtime_error("list data byte order mismatch");
+		if (in.read_raw<encoding>() != codec<T>::kind || in.read_raw<std::uint32_t>() != sizeof(T))
+			throw std::runtime_error("list data encoding mismatch");
+		return in.read_raw<std::uint64_t>();
+	}
+
+	template<typename T>
+	void save(const list<T>& source, writer& out)
+	{
+		codec<T> encoder;
+		write_header<T>(out, source.size());
+		source.for_each([&](const T& value) { encoder.encode(out, value); });
+		out.flush();
+	}
+
+	template<typename T>
+	void load(list<T>& target, reader& in)
+	{
+		const auto count = static_cast<std::size_t>(read_header<T>(in));
+
+		codec<T> decoder;
+		list<T> loaded;
+		loaded.append_n(count, [&] { return decoder.decode(in); });
+
+		target.clear();
+		target.splice(target.end(), loaded);
+	}
+
+	template<typename T>
+	void save(const list<T>& source, std::ostream& out)
+	{
+		writer sink(out);
+		save(source, sink);
+	}
+
+	template<typename T>
+	void save(const list<T>& source, int fd)
+	{
+		writer sink(fd);
+		save(source, sink);
+	}
+
+	template<typename T>
+	void load(list<T>& target, std::istream& in)
+	{
+		reader source(in);
+		load(target, source);
+	}
+
+	template<typename T>
+	void load(list<T>& target, int fd)
+	{
+		reader source(fd);
+		load(target, source);
+	}
+}
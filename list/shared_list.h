@@ -0,0 +1,657 @@
+#pragma once
+
+#include<algorithm>
+#include<atomic>
+#include<cstddef>
+#include<initializer_list>
+#include<iterator>
+#include<memory>
+#include<stdexcept>
+#include<utility>
+#include<vector>
+
+template<class T>
+class shared_list
+{
+public:
+	static constexpr std::size_t segment_capacity = 64;
+
+private:
+	struct node
+	{
+		node* previous;
+		node* next;
+		T value;
+
+		template<typename... Args>
+		node(Args&&...args) : previous(nullptr), next(nullptr), value(std::forward<Args>(args)...) {}
+	};
+
+	struct segment
+	{
+		std::atomic<std::size_t> references{ 1 };
+		node* first = nullptr;
+		node* last = nullptr;
+		std::size_t count = 0;
+
+		segment() = default;
+		segment(const segment&) = delete;
+		segment& operator=(const segment&) = delete;
+
+		~segment()
+		{
+			for (node* current = first; current;)
+			{
+				node* next = current->next;
+				delete current;
+				current = next;
+			}
+		}
+
+		void linkBefore(node* where, node* created) noexcept
+		{
+			created->next = where;
+			created->previous = where ? where->previous : last;
+			if (created->previous)
+				created->previous->next = created;
+			else
+				first = created;
+			if (where)
+				where->previous = created;
+			else
+				last = created;
+			++count;
+		}
+
+		void unlink(node* target) noexcept
+		{
+			if (target->previous)
+				target->previous->next = target->next;
+			else
+				first = target->next;
+			if (target->next)
+				target->next->previous = target->previous;
+			else
+				last = target->previous;
+			--count;
+		}
+
+		node* at(std::size_t offset) const noexcept
+		{
+			node* current = first;
+			while (offset--)
+				current = current->next;
+			return current;
+		}
+
+		std::size_t offsetOf(const node* target) const noexcept
+		{
+			std::size_t offset = 0;
+			for (const node* current = first; current != target; current = current->next)
+				++offset;
+			return offset;
+		}
+	};
+
+	struct spine
+	{
+		std::atomic<std::size_t> references{ 1 };
+		std::vector<segment*> segments;
+		std::size_t nelms = 0;
+
+		spine() = default;
+		spine(const spine&) = delete;
+		spine& operator=(const spine&) = delete;
+
+		~spine()
+		{
+			for (segment* target : segments)
+				release(target);
+		}
+	};
+
+	spine* root;
+
+	template<class Shared>
+	static void retain(Shared* target) noexcept
+	{
+		target->references.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	template<class Shared>
+	static void release(Shared* target) noexcept
+	{
+		if (target && target->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			delete target;
+	}
+
+	template<class Shared>
+	static bool unique(const Shared* target) noexcept
+	{
+		return target->references.load(std::memory_order_acquire) == 1;
+	}
+
+	static segment* cloneSegment(const segment& source)
+	{
+		auto copy = std::make_unique<segment>();
+		for (const node* current = source.first; current; current = current->next)
+			copy->linkBefore(nullptr, new node(current->value));
+		return copy.release();
+	}
+
+	spine& ownSpine()
+	{
+		if (!root)
+			root = new spine;
+		else if (!unique(root))
+		{
+			auto copy = std::make_unique<spine>();
+			copy->segments = root->segments;
+			copy->nelms = root->nelms;
+			for (segment* target : copy->segments)
+				retain(target);
+			release(std::exchange(root, copy.release()));
+		}
+		return *root;
+	}
+
+	segment& ownSegment(std::size_t index)
+	{
+		spine& owned = ownSpine();
+		segment*& target = owned.segments[index];
+		if (!unique(target))
+		{
+			segment* copy = cloneSegment(*target);
+			release(std::exchange(target, copy));
+		}
+		return *target;
+	}
+
+	void splitIfFull(std::size_t index)
+	{
+		segment& full = *root->segments[index];
+		if (full.count <= segment_capacity)
+			return;
+
+		root->segments.reserve(root->segments.size() + 1);
+		auto upper = std::make_unique<segment>();
+		node* middle = full.at(full.count / 2);
+		upper->first = middle;
+		upper->last = full.last;
+		upper->count = full.count - full.count / 2;
+		full.last = middle->previous;
+		full.last->next = nullptr;
+		middle->previous = nullptr;
+		full.count -= upper->count;
+		root->segments.insert(root->segments.begin() + std::ptrdiff_t(index) + 1, upper.release());
+	}
+
+	void dropIfEmpty(std::size_t index)
+	{
+		if (root->segments[index]->count != 0)
+			return;
+		release(root->segments[index]);
+		root->segments.erase(root->segments.begin() + std::ptrdiff_t(index));
+	}
+
+	void splitBefore(std::size_t index, std::size_t offset)
+	{
+		if (offset == 0)
+			return;
+		segment& target = ownSegment(index);
+		if (offset == target.count)
+			return;
+
+		root->segments.reserve(root->segments.size() + 1);
+		auto upper = std::make_unique<segment>();
+		node* middle = target.at(offset);
+		upper->first = middle;
+		upper->last = target.last;
+		upper->count = target.count - offset;
+		target.last = middle->previous;
+		target.last->next = nullptr;
+		middle->previous = nullptr;
+		target.count = offset;
+		root->segments.insert(root->segments.begin() + std::ptrdiff_t(index) + 1, upper.release());
+	}
+
+	bool absorbNext(std::size_t index)
+	{
+		if (index + 1 >= root->segments.size())
+			return false;
+		segment* target = root->segments[index];
+		segment* next = root->segments[index + 1];
+		if (target->count + next->count > segment_capacity / 2 || !unique(target) || !unique(next))
+			return false;
+
+		target->last->next = next->first;
+		next->first->previous = target->last;
+		target->last = next->last;
+		target->count += next->count;
+		next->first = nullptr;
+		next->last = nullptr;
+		next->count = 0;
+		release(next);
+		root->segments.erase(root->segments.begin() + std::ptrdiff_t(index) + 1);
+		return true;
+	}
+
+	std::size_t mergeAround(std::size_t index)
+	{
+		if (index >= root->segments.size() || root->segments[index]->count >= segment_capacity / 4)
+			return index;
+		absorbNext(index);
+		if (index > 0 && absorbNext(index - 1))
+			return index - 1;
+		return index;
+	}
+
+	std::size_t segmentOf(std::size_t index, const node* target) const noexcept
+	{
+		for (const node* current = root->segments[index]->first; current; current = current->next)
+			if (current == target)
+				return index;
+		return index + 1;
+	}
+
+	std::size_t segmentsIn() const noexcept
+	{
+		return root ? root->segments.size() : 0;
+	}
+
+public:
+	class const_iterator
+	{
+	private:
+		const spine* owner;
+		std::size_t index;
+		node* current;
+
+	public:
+		friend class shared_list;
+
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const T*;
+		using reference = const T&;
+
+		const_iterator() : owner(nullptr), index(0), current(nullptr) {}
+		const_iterator(const spine* owner_, std::size_t index_, node* current_) : owner(owner_), index(index_), current(current_) {}
+
+		const_iterator& operator++()
+		{
+			current = current->next;
+			if (!current && ++index < owner->segments.size())
+				current = owner->segments[index]->first;
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			auto aux = *this;
+			++(*this);
+			return aux;
+		}
+
+		const_iterator& operator--()
+		{
+			if (current && current->previous)
+				current = current->previous;
+			else
+				current = owner->segments[--index]->last;
+			return *this;
+		}
+
+		const_iterator operator--(int)
+		{
+			auto aux = *this;
+			--(*this);
+			return aux;
+		}
+
+		reference operator*() const
+		{
+			if (!current)
+				throw std::runtime_error("Invalid ptr to use '*' ");
+			return current->value;
+		}
+
+		pointer operator->() const
+		{
+			return &**this;
+		}
+
+		bool operator==(const const_iterator& it) const noexcept
+		{
+			return index == it.index && current == it.current;
+		}
+	};
+
+	using iterator = const_iterator;
+
+	shared_list() noexcept : root(nullptr) {}
+
+	shared_list(const std::initializer_list<T>& ilist) : shared_list()
+	{
+		for (const T& e : ilist)
+			push_back(e);
+	}
+
+	shared_list(const shared_list& other) noexcept : root(other.root)
+	{
+		if (root)
+			retain(root);
+	}
+
+	shared_list(shared_list&& other) noexcept : root(std::exchange(other.root, nullptr)) {}
+
+	shared_list& operator=(const shared_list& other) noexcept
+	{
+		if (root != other.root)
+		{
+			if (other.root)
+				retain(other.root);
+			release(std::exchange(root, other.root));
+		}
+		return *this;
+	}
+
+	shared_list& operator=(shared_list&& other) noexcept
+	{
+		if (this != &other)
+			release(std::exchange(root, std::exchange(other.root, nullptr)));
+		return *this;
+	}
+
+	~shared_list()
+	{
+		release(root);
+	}
+
+	bool operator==(const shared_list& other) const
+	{
+		if (root == other.root)
+			return true;
+		return size() == other.size() && std::equal(begin(), end(), other.begin());
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept
+	{
+		return root ? root->nelms : 0;
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return size() == 0;
+	}
+
+	[[nodiscard]] std::size_t use_count() const noexcept
+	{
+		return root ? root->references.load(std::memory_order_relaxed) : 0;
+	}
+
+	[[nodiscard]] std::size_t segment_count() const noexcept
+	{
+		return segmentsIn();
+	}
+
+	[[nodiscard]] std::size_t shared_segment_count() const noexcept
+	{
+		std::size_t shared = 0;
+		for (std::size_t i = 0; i < segmentsIn(); i++)
+			shared += !unique(root->segments[i]);
+		return shared;
+	}
+
+	const T& front() const
+	{
+		if (empty())
+			throw std::length_error("front called on empty list");
+		return root->segments.front()->first->value;
+	}
+
+	const T& back() const
+	{
+		if (empty())
+			throw std::length_error("back called on empty list");
+		return root->segments.back()->last->value;
+	}
+
+	[[nodiscard]] const_iterator begin() const noexcept
+	{
+		return empty() ? end() : const_iterator(root, 0, root->segments.front()->first);
+	}
+
+	[[nodiscard]] const_iterator end() const noexcept
+	{
+		return const_iterator(root, segmentsIn(), nullptr);
+	}
+
+	[[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+	[[nodiscard]] const_iterator cend() const noexcept { return end(); }
+
+	template<typename... Args>
+	iterator emplace(const_iterator it, Args&&...args)
+	{
+		auto created = std::make_unique<node>(std::forward<Args>(args)...);
+		std::size_t index = it.index;
+		std::size_t offset = 0;
+		if (it.current)
+			offset = root->segments[index]->offsetOf(it.current);
+		else if (index > 0)
+			offset = root->segments[--index]->count;
+
+		spine& owned = ownSpine();
+		if (owned.segments.empty())
+			owned.segments.push_back(new segment);
+		else if (offset == owned.segments[index]->count && offset >= segment_capacity)
+		{
+			owned.segments.insert(owned.segments.begin() + std::ptrdiff_t(index) + 1, new segment);
+			++index;
+			offset = 0;
+		}
+
+		segment& target = ownSegment(index);
+		node* placed = created.release();
+		target.linkBefore(offset < target.count ? target.at(offset) : nullptr, placed);
+		++owned.nelms;
+		splitIfFull(index);
+
+		if (index + 1 < owned.segments.size() && owned.segments[index]->count <= offset)
+			++index;
+		return const_iterator(root, index, placed);
+	}
+
+	template<typename... Args>
+	void emplace_back(Args&&...args)
+	{
+		emplace(end(), std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	void emplace_front(Args&&...args)
+	{
+		emplace(begin(), std::forward<Args>(args)...);
+	}
+
+	iterator insert(const_iterator it, const T& newvalue)
+	{
+		return emplace(it, newvalue);
+	}
+
+	iterator insert(const_iterator it, T&& newvalue)
+	{
+		return emplace(it, std::move(newvalue));
+	}
+
+	void push_back(const T& newvalue)
+	{
+		emplace_back(newvalue);
+	}
+
+	void push_back(T&& newvalue)
+	{
+		emplace_back(std::move(newvalue));
+	}
+
+	void push_front(const T& newvalue)
+	{
+		emplace_front(newvalue);
+	}
+
+	void push_front(T&& newvalue)
+	{
+		emplace_front(std::move(newvalue));
+	}
+
+	iterator pop(const_iterator it)
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		if (!it.current)
+			throw std::runtime_error("pop called on head");
+
+		std::size_t index = it.index;
+		const std::size_t offset = root->segments[index]->offsetOf(it.current);
+		segment& target = ownSegment(index);
+		node* removed = target.at(offset);
+		node* next = removed->next;
+		target.unlink(removed);
+		delete removed;
+		--root->nelms;
+
+		const bool emptied = target.count == 0;
+		if (emptied)
+			dropIfEmpty(index);
+		if (!next)
+		{
+			const std::size_t following = emptied ? index : index + 1;
+			if (following >= root->segments.size())
+			{
+				if (!emptied)
+					mergeAround(index);
+				return end();
+			}
+			next = root->segments[following]->first;
+		}
+		index = mergeAround(index);
+		return const_iterator(root, segmentOf(index, next), next);
+	}
+
+	void pop_back()
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		pop(std::prev(end()));
+	}
+
+	void pop_front()
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		pop(begin());
+	}
+
+	template<class Function>
+	iterator update(const_iterator it, Function function)
+	{
+		if (!it.current)
+			throw std::runtime_error("update called on head");
+		const std::size_t offset = root->segments[it.index]->offsetOf(it.current);
+		segment& target = ownSegment(it.index);
+		node* changed = target.at(offset);
+		function(changed->value);
+		return const_iterator(root, it.index, changed);
+	}
+
+	void splice(const_iterator where, shared_list& rightlist)
+	{
+		if (rightlist.empty() || &rightlist == this)
+			return;
+
+		std::size_t index = 0;
+		if (where.current)
+		{
+			const std::size_t offset = root->segments[where.index]->offsetOf(where.current) + 1;
+			splitBefore(where.index, offset);
+			index = where.index + 1;
+		}
+
+		spine& owned = ownSpine();
+		const std::vector<segment*>& donated = rightlist.root->segments;
+		const std::size_t added = donated.size();
+		owned.segments.insert(owned.segments.begin() + std::ptrdiff_t(index), donated.begin(), donated.end());
+		for (segment* target : donated)
+			retain(target);
+		owned.nelms += rightlist.root->nelms;
+		rightlist.clear();
+
+		mergeAround(index + added);
+		mergeAround(index + added - 1);
+		mergeAround(index);
+	}
+
+	template<class Function>
+	Function for_each(Function function) const
+	{
+		for (std::size_t i = 0; i < segmentsIn(); i++)
+			for (const node* current = root->segments[i]->first; current; current = current->next)
+				function(current->value);
+		return function;
+	}
+
+	template<class Function>
+	void transform(Function function)
+	{
+		for (std::size_t i = 0; i < segmentsIn(); i++)
+			for (node* current = ownSegment(i).first; current; current = current->next)
+				current->value = function(std::as_const(current->value));
+	}
+
+	template<class Condition>
+	std::size_t remove_if(Condition condition)
+	{
+		std::size_t removed = 0;
+		for (std::size_t i = 0; i < segmentsIn();)
+		{
+			segment* shared = root->segments[i];
+			node* match = shared->first;
+			std::size_t offset = 0;
+			while (match && !condition(std::as_const(match->value)))
+			{
+				match = match->next;
+				++offset;
+			}
+			if (!match)
+			{
+				++i;
+				continue;
+			}
+
+			segment& target = ownSegment(i);
+			node* current = &target == shared ? match : target.at(offset);
+			while (current)
+			{
+				node* next = current->next;
+				target.unlink(current);
+				delete current;
+				--root->nelms;
+				++removed;
+				current = next;
+				while (current && !condition(std::as_const(current->value)))
+					current = current->next;
+			}
+			if (target.count == 0)
+				dropIfEmpty(i);
+			else if (target.count >= segment_capacity / 4 || i == 0 || !absorbNext(i - 1))
+				++i;
+		}
+		return removed;
+	}
+
+	void clear() noexcept
+	{
+		release(std::exchange(root, nullptr));
+	}
+};
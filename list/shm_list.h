@@ -0,0 +1,526 @@
+#pragma once
+
+#include<atomic>
+#include<cerrno>
+#include<cstddef>
+#include<cstdint>
+#include<functional>
+#include<new>
+#include<optional>
+#include<stdexcept>
+#include<string>
+#include<system_error>
+#include<type_traits>
+#include<utility>
+#include<vector>
+#include<fcntl.h>
+#include<pthread.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#include "offset_link.h"
+
+template<class T>
+	requires std::is_trivially_copyable_v<T>
+class shm_list
+{
+private:
+	struct node : public offset_link
+	{
+		T value;
+	};
+
+	struct header
+	{
+		std::atomic<std::uint32_t> ready;
+		std::uint32_t valueSize;
+		std::uint64_t capacity;
+		std::uint64_t highWater;
+		std::uint64_t size;
+		std::uint64_t freeHead;
+		pthread_mutex_t mutex;
+		pthread_cond_t notEmpty;
+		pthread_cond_t notFull;
+		offset_link head;
+	};
+
+	static constexpr std::uint32_t segment_magic = 0x4c53484d;
+	static constexpr std::uint64_t no_slot = ~std::uint64_t(0);
+	static constexpr std::size_t nodes_offset = (sizeof(header) + alignof(node) - 1) / alignof(node) * alignof(node);
+
+	std::byte* base;
+	std::size_t mappedBytes;
+
+	[[noreturn]] static void fail(int error, const char* what)
+	{
+		throw std::system_error(error, std::generic_category(), what);
+	}
+
+	static void check(int result, const char* what)
+	{
+		if (result != 0)
+			fail(result, what);
+	}
+
+	header& meta() const noexcept
+	{
+		return *reinterpret_cast<header*>(base);
+	}
+
+	offset_link* sentinel() const noexcept
+	{
+		return &meta().head;
+	}
+
+	node* slot(std::uint64_t index) const noexcept
+	{
+		return reinterpret_cast<node*>(base + nodes_offset + index * sizeof(node));
+	}
+
+	std::uint64_t indexOf(const offset_link* target) const noexcept
+	{
+		return static_cast<std::uint64_t>(reinterpret_cast<const std::byte*>(target) - (base + nodes_offset)) / sizeof(node);
+	}
+
+	class guard
+	{
+	private:
+		const shm_list& owner;
+
+	public:
+		explicit guard(const shm_list& owner_) : owner(owner_)
+		{
+			owner.acquired(pthread_mutex_lock(&owner.meta().mutex), "pthread_mutex_lock");
+		}
+
+		guard(const guard&) = delete;
+		guard& operator=(const guard&) = delete;
+
+		~guard()
+		{
+			pthread_mutex_unlock(&owner.meta().mutex);
+		}
+
+		void wait(pthread_cond_t& condition)
+		{
+			owner.acquired(pthread_cond_wait(&condition, &owner.meta().mutex), "pthread_cond_wait");
+		}
+	};
+
+	void acquired(int result, const char* what) const
+	{
+		if (result != EOWNERDEAD)
+		{
+			check(result, what);
+			return;
+		}
+
+		try
+		{
+			const_cast<shm_list*>(this)->repair();
+			check(pthread_mutex_consistent(&meta().mutex), "pthread_mutex_consistent");
+		}
+		catch (...)
+		{
+			pthread_mutex_unlock(&meta().mutex);
+			throw;
+		}
+	}
+
+	std::uint64_t checkedIndex(const offset_link* target) const
+	{
+		const auto offset = reinterpret_cast<std::intptr_t>(target) - reinterpret_cast<std::intptr_t>(base);
+		if (offset < std::intptr_t(nodes_offset) || (offset - std::intptr_t(nodes_offset)) % std::intptr_t(sizeof(node)) != 0)
+			throw std::runtime_error("shm_list segment is corrupt");
+		const std::uint64_t index = indexOf(target);
+		if (index >= meta().highWater)
+			throw std::runtime_error("shm_list segment is corrupt");
+		return index;
+	}
+
+	void repair()
+	{
+		header& h = meta();
+		if (h.highWater > h.capacity)
+			throw std::runtime_error("shm_list segment is corrupt");
+		std::vector<bool> reachable(h.highWater);
+		std::uint64_t count = 0;
+
+		offset_link* previous = sentinel();
+		for (offset_link* current = previous->next_link(); current != sentinel(); current = current->next_link())
+		{
+			const std::uint64_t index = checkedIndex(current);
+			if (reachable[index])
+				throw std::runtime_error("shm_list segment is corrupt");
+			reachable[index] = true;
+			++count;
+			current->set_previous(previous);
+			previous = current;
+		}
+		sentinel()->set_previous(previous);
+
+		h.size = count;
+		h.freeHead = no_slot;
+		for (std::uint64_t i = h.highWater; i-- > 0;)
+			if (!reachable[i])
+				release(slot(i));
+	}
+
+	void map(int fd, std::size_t bytes)
+	{
+		void* mapped = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (mapped == MAP_FAILED)
+			fail(errno, "mmap");
+		base = static_cast<std::byte*>(mapped);
+		mappedBytes = bytes;
+	}
+
+	void initialize(std::size_t capacity)
+	{
+		header* h = ::new (static_cast<void*>(base)) header{};
+		h->valueSize = sizeof(T);
+		h->capacity = capacity;
+		h->freeHead = no_slot;
+
+		pthread_mutexattr_t mutexAttributes;
+		check(pthread_mutexattr_init(&mutexAttributes), "pthread_mutexattr_init");
+		const char* mutexStep = "pthread_mutexattr_setpshared";
+		int mutexResult = pthread_mutexattr_setpshared(&mutexAttributes, PTHREAD_PROCESS_SHARED);
+		if (mutexResult == 0)
+		{
+			mutexStep = "pthread_mutexattr_setrobust";
+			mutexResult = pthread_mutexattr_setrobust(&mutexAttributes, PTHREAD_MUTEX_ROBUST);
+		}
+		if (mutexResult == 0)
+		{
+			mutexStep = "pthread_mutex_init";
+			mutexResult = pthread_mutex_init(&h->mutex, &mutexAttributes);
+		}
+		pthread_mutexattr_destroy(&mutexAttributes);
+		check(mutexResult, mutexStep);
+
+		pthread_condattr_t conditionAttributes;
+		check(pthread_condattr_init(&conditionAttributes), "pthread_condattr_init");
+		const char* conditionStep = "pthread_condattr_setpshared";
+		int conditionResult = pthread_condattr_setpshared(&conditionAttributes, PTHREAD_PROCESS_SHARED);
+		if (conditionResult == 0)
+		{
+			conditionStep = "pthread_cond_init";
+			conditionResult = pthread_cond_init(&h->notEmpty, &conditionAttributes);
+		}
+		if (conditionResult == 0)
+		{
+			conditionResult = pthread_cond_init(&h->notFull, &conditionAttributes);
+			if (conditionResult != 0)
+				pthread_cond_destroy(&h->notEmpty);
+		}
+		pthread_condattr_destroy(&conditionAttributes);
+		if (conditionResult != 0)
+			pthread_mutex_destroy(&h->mutex);
+		check(conditionResult, conditionStep);
+
+		h->ready.store(segment_magic, std::memory_order_release);
+	}
+
+	node* allocate() noexcept
+	{
+		header& h = meta();
+		if (h.freeHead != no_slot)
+		{
+			node* target = slot(h.freeHead);
+			h.freeHead = static_cast<std::uint64_t>(target->next);
+			return target;
+		}
+		return slot(h.highWater++);
+	}
+
+	void release(node* target) noexcept
+	{
+		header& h = meta();
+		target->next = static_cast<std::int64_t>(h.freeHead);
+		h.freeHead = indexOf(target);
+	}
+
+	[[nodiscard]] bool full() const noexcept
+	{
+		return meta().size == meta().capacity;
+	}
+
+	template<typename... Args>
+	void emplaceBefore(offset_link* where, Args&&... args)
+	{
+		node* newnode = allocate();
+		try
+		{
+			::new (static_cast<void*>(&newnode->value)) T(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			release(newnode);
+			throw;
+		}
+
+		offset_link* before = where->previous_link();
+		newnode->set_next(where);
+		newnode->set_previous(before);
+		before->set_next(newnode);
+		where->set_previous(newnode);
+		++meta().size;
+		pthread_cond_signal(&meta().notEmpty);
+	}
+
+	void unlink(offset_link* target) noexcept
+	{
+		offset_link* before = target->previous_link();
+		offset_link* after = target->next_link();
+		before->set_next(after);
+		after->set_previous(before);
+		--meta().size;
+		release(static_cast<node*>(target));
+		pthread_cond_signal(&meta().notFull);
+	}
+
+	T takeFront() noexcept
+	{
+		offset_link* first = sentinel()->next_link();
+		T value = static_cast<node*>(first)->value;
+		unlink(first);
+		return value;
+	}
+
+public:
+	shm_list(const std::string& name, std::size_t capacity) : base(nullptr), mappedBytes(0)
+	{
+		if (capacity == 0)
+			throw std::invalid_argument("shm_list capacity must be positive");
+
+		const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+		if (fd < 0)
+			fail(errno, "shm_open");
+
+		try
+		{
+			const std::size_t bytes = nodes_offset + capacity * sizeof(node);
+			if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+				fail(errno, "ftruncate");
+			map(fd, bytes);
+			initialize(capacity);
+		}
+		catch (...)
+		{
+			if (base)
+				::munmap(base, mappedBytes);
+			::close(fd);
+			::shm_unlink(name.c_str());
+			throw;
+		}
+		::close(fd);
+	}
+
+	explicit shm_list(const std::string& name) : base(nullptr), mappedBytes(0)
+	{
+		const int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+		if (fd < 0)
+			fail(errno, "shm_open");
+
+		try
+		{
+			struct stat status;
+			if (::fstat(fd, &status) != 0)
+				fail(errno, "fstat");
+			if (static_cast<std::size_t>(status.st_size) < nodes_offset)
+				throw std::runtime_error("shm_list segment is not initialized");
+			map(fd, static_cast<std::size_t>(status.st_size));
+
+			const header& h = meta();
+			if (h.ready.load(std::memory_order_acquire) != segment_magic)
+				throw std::runtime_error("shm_list segment is not initialized");
+			if (h.valueSize != sizeof(T) || nodes_offset + h.capacity * sizeof(node) > mappedBytes)
+				throw std::runtime_error("shm_list segment format mismatch");
+		}
+		catch (...)
+		{
+			if (base)
+				::munmap(base, mappedBytes);
+			::close(fd);
+			throw;
+		}
+		::close(fd);
+	}
+
+	shm_list(const shm_list&) = delete;
+	shm_list& operator=(const shm_list&) = delete;
+
+	shm_list(shm_list&& other) noexcept
+		: base(std::exchange(other.base, nullptr)),
+		mappedBytes(std::exchange(other.mappedBytes, 0)) {}
+
+	~shm_list()
+	{
+		if (base)
+			::munmap(base, mappedBytes);
+	}
+
+	static void remove(const std::string& name) noexcept
+	{
+		::shm_unlink(name.c_str());
+	}
+
+	[[nodiscard]] std::size_t size() const
+	{
+		guard lock(*this);
+		return static_cast<std::size_t>(meta().size);
+	}
+
+	[[nodiscard]] bool empty() const
+	{
+		return size() == 0;
+	}
+
+	[[nodiscard]] std::size_t capacity() const noexcept
+	{
+		return static_cast<std::size_t>(meta().capacity);
+	}
+
+	template <typename... Args>
+	[[nodiscard]] bool try_emplace_back(Args &&...args)
+	{
+		guard lock(*this);
+		if (full())
+			return false;
+		emplaceBefore(sentinel(), std::forward<Args>(args)...);
+		return true;
+	}
+
+	template <typename... Args>
+	[[nodiscard]] bool try_emplace_front(Args &&...args)
+	{
+		guard lock(*this);
+		if (full())
+			return false;
+		emplaceBefore(sentinel()->next_link(), std::forward<Args>(args)...);
+		return true;
+	}
+
+	template <typename... Args>
+	void emplace_back(Args &&...args)
+	{
+		if (!try_emplace_back(std::forward<Args>(args)...))
+			throw std::length_error("shm_list capacity exceeded");
+	}
+
+	template <typename... Args>
+	void emplace_front(Args &&...args)
+	{
+		if (!try_emplace_front(std::forward<Args>(args)...))
+			throw std::length_error("shm_list capacity exceeded");
+	}
+
+	void push_back(const T& newvalue)
+	{
+		emplace_back(newvalue);
+	}
+
+	void push_front(const T& newvalue)
+	{
+		emplace_front(newvalue);
+	}
+
+	template <typename... Args>
+	void emplace_back_wait(Args &&...args)
+	{
+		guard lock(*this);
+		while (full())
+			lock.wait(meta().notFull);
+		emplaceBefore(sentinel(), std::forward<Args>(args)...);
+	}
+
+	void push_back_wait(const T& newvalue)
+	{
+		emplace_back_wait(newvalue);
+	}
+
+	void pop_front()
+	{
+		guard lock(*this);
+		if (meta().size == 0)
+			throw std::length_error("pop called on empty list");
+		unlink(sentinel()->next_link());
+	}
+
+	void pop_back()
+	{
+		guard lock(*this);
+		if (meta().size == 0)
+			throw std::length_error("pop called on empty list");
+		unlink(sentinel()->previous_link());
+	}
+
+	[[nodiscard]] std::optional<T> try_pop_front()
+	{
+		guard lock(*this);
+		if (meta().size == 0)
+			return std::nullopt;
+		return takeFront();
+	}
+
+	[[nodiscard]] T pop_front_wait()
+	{
+		guard lock(*this);
+		while (meta().size == 0)
+			lock.wait(meta().notEmpty);
+		return takeFront();
+	}
+
+	template<class Function>
+	bool consume_front(Function function)
+	{
+		guard lock(*this);
+		if (meta().size == 0)
+			return false;
+		offset_link* first = sentinel()->next_link();
+		function(static_cast<node*>(first)->value);
+		unlink(first);
+		return true;
+	}
+
+	void clear()
+	{
+		guard lock(*this);
+		header& h = meta();
+		h.head.reset();
+		h.size = 0;
+		h.highWater = 0;
+		h.freeHead = no_slot;
+		pthread_cond_broadcast(&h.notFull);
+	}
+
+	template<class Function>
+	Function for_each(Function function) const
+	{
+		guard lock(*this);
+		for (const offset_link* current = sentinel()->next_link(); current != sentinel(); current = current->next_link())
+			function(std::as_const(static_cast<const node*>(current)->value));
+		return function;
+	}
+
+	template<class Condition>
+	[[nodiscard]] std::size_t count_if(Condition condition) const
+	{
+		std::size_t total = 0;
+		for_each([&](const T& value) { total += bool(condition(value)); });
+		return total;
+	}
+
+	[[nodiscard]] bool contains(const T& target) const
+	{
+		return count_if([&](const T& value) { return value == target; }) != 0;
+	}
+
+	template<typename U, class BinaryOperation = std::plus<>>
+	[[nodiscard]] U accumulate(U init, BinaryOperation operation = {}) const
+	{
+		for_each([&](const T& value) { init = operation(std::move(init), value); });
+		return init;
+	}
+};
@@ -0,0 +1,254 @@
+#pragma once
+
+#include<cstddef>
+#include<cstring>
+#include<concepts>
+#include<type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define LIST_SIMD_X86 1
+#endif
+
+namespace list_simd
+{
+	template<typename T>
+	concept vectorizable = std::is_arithmetic_v<T> && !std::same_as<T, bool> && sizeof(T) >= 4;
+
+	inline constexpr std::size_t gather_chunk = 256;
+
+	template<typename T>
+	struct scalar
+	{
+		static T sum(const T* data, std::size_t n)
+		{
+			T total{};
+			for (std::size_t i = 0; i < n; i++)
+				total += data[i];
+			return total;
+		}
+
+		static T min(const T* data, std::size_t n)
+		{
+			T result = data[0];
+			for (std::size_t i = 1; i < n; i++)
+				result = data[i] < result ? data[i] : result;
+			return result;
+		}
+
+		static T max(const T* data, std::size_t n)
+		{
+			T result = data[0];
+			for (std::size_t i = 1; i < n; i++)
+				result = result < data[i] ? data[i] : result;
+			return result;
+		}
+
+		static std::size_t count(const T* data, std::size_t n, T target)
+		{
+			std::size_t total = 0;
+			for (std::size_t i = 0; i < n; i++)
+				total += data[i] == target;
+			return total;
+		}
+
+		static std::size_t mismatch(const T* left, const T* right, std::size_t n)
+		{
+			std::size_t i = 0;
+			while (i < n && left[i] == right[i])
+				++i;
+			return i;
+		}
+	};
+
+#ifdef LIST_SIMD_X86
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+	template<typename T, std::size_t Bytes>
+	struct lanes
+	{
+		typedef T vector __attribute__((vector_size(Bytes)));
+		static constexpr std::size_t width = Bytes / sizeof(T);
+
+		[[gnu::always_inline]] static vector load(const T* data)
+		{
+			vector v;
+			std::memcpy(&v, data, Bytes);
+			return v;
+		}
+
+		[[gnu::always_inline]] static T sum(const T* data, std::size_t n)
+		{
+			vector acc{};
+			std::size_t i = 0;
+			for (; i + width <= n; i += width)
+				acc += load(data + i);
+
+			T total{};
+			for (std::size_t lane = 0; lane < width; lane++)
+				total += acc[lane];
+			for (; i < n; i++)
+				total += data[i];
+			return total;
+		}
+
+		[[gnu::always_inline]] static T min(const T* data, std::size_t n)
+		{
+			if (n < width)
+				return scalar<T>::min(data, n);
+
+			vector acc = load(data);
+			std::size_t i = width;
+			for (; i + width <= n; i += width)
+			{
+				const vector v = load(data + i);
+				acc = v < acc ? v : acc;
+			}
+
+			T result = acc[0];
+			for (std::size_t lane = 1; lane < width; lane++)
+				result = acc[lane] < result ? acc[lane] : result;
+			for (; i < n; i++)
+				result = data[i] < result ? data[i] : result;
+			return result;
+		}
+
+		[[gnu::always_inline]] static T max(const T* data, std::size_t n)
+		{
+			if (n < width)
+				return scalar<T>::max(data, n);
+
+			vector acc = load(data);
+			std::size_t i = width;
+			for (; i + width <= n; i += width)
+			{
+				const vector v = load(data + i);
+				acc = acc < v ? v : acc;
+			}
+
+			T result = acc[0];
+			for (std::size_t lane = 1; lane < width; lane++)
+				result = result < acc[lane] ? acc[lane] : result;
+			for (; i < n; i++)
+				result = result < data[i] ? data[i] : result;
+			return result;
+		}
+
+		[[gnu::always_inline]] static std::size_t count(const T* data, std::size_t n, T target)
+		{
+			const vector targets = vector{} + target;
+			decltype(targets == targets) acc{};
+			std::size_t i = 0;
+			for (; i + width <= n; i += width)
+				acc -= load(data + i) == targets;
+
+			std::size_t total = 0;
+			for (std::size_t lane = 0; lane < width; lane++)
+				total += static_cast<std::size_t>(acc[lane]);
+			for (; i < n; i++)
+				total += data[i] == target;
+			return total;
+		}
+
+		[[gnu::always_inline]] static std::size_t mismatch(const T* left, const T* right, std::size_t n)
+		{
+			std::size_t i = 0;
+			for (; i + width <= n; i += width)
+			{
+				const auto differs = load(left + i) != load(right + i);
+				bool any = false;
+				for (std::size_t lane = 0; lane < width; lane++)
+					any |= differs[lane] != 0;
+				if (any)
+					break;
+			}
+			return i + scalar<T>::mismatch(left + i, right + i, n - i);
+		}
+	};
+
+	inline bool hasAvx2()
+	{
+		static const bool supported = []
+			{
+				__builtin_cpu_init();
+				return __builtin_cpu_supports("avx2") != 0;
+			}();
+		return supported;
+	}
+
+	template<typename T>
+	[[gnu::target("avx2")]] T sumAvx2(const T* data, std::size_t n) { return lanes<T, 32>::sum(data, n); }
+
+	template<typename T>
+	[[gnu::target("avx2")]] T minAvx2(const T* data, std::size_t n) { return lanes<T, 32>::min(data, n); }
+
+	template<typename T>
+	[[gnu::target("avx2")]] T maxAvx2(const T* data, std::size_t n) { return lanes<T, 32>::max(data, n); }
+
+	template<typename T>
+	[[gnu::target("avx2")]] std::size_t countAvx2(const T* data, std::size_t n, T target) { return lanes<T, 32>::count(data, n, target); }
+
+	template<typename T>
+	[[gnu::target("avx2")]] std::size_t mismatchAvx2(const T* left, const T* right, std::size_t n) { return lanes<T, 32>::mismatch(left, right, n); }
+#pragma GCC diagnostic pop
+#endif
+
+	template<vectorizable T>
+	T sum(const T* data, std::size_t n)
+	{
+#ifdef LIST_SIMD_X86
+		if (hasAvx2())
+			return sumAvx2(data, n);
+		return lanes<T, 16>::sum(data, n);
+#else
+		return scalar<T>::sum(data, n);
+#endif
+	}
+
+	template<vectorizable T>
+	T min(const T* data, std::size_t n)
+	{
+#ifdef LIST_SIMD_X86
+		if (hasAvx2())
+			return minAvx2(data, n);
+		return lanes<T, 16>::min(data, n);
+#else
+		return scalar<T>::min(data, n);
+#endif
+	}
+
+	template<vectorizable T>
+	T max(const T* data, std::size_t n)
+	{
+#ifdef LIST_SIMD_X86
+		if (hasAvx2())
+			return maxAvx2(data, n);
+		return lanes<T, 16>::max(data, n);
+#else
+		return scalar<T>::max(data, n);
+#endif
+	}
+
+	template<vectorizable T>
+	std::size_t count(const T* data, std::size_t n, T target)
+	{
+#ifdef LIST_SIMD_X86
+		if (hasAvx2())
+			return countAvx2(data, n, target);
+		return lanes<T, 16>::count(data, n, target);
+#else
+		return scalar<T>::count(data, n, target);
+#endif
+	}
+
+	template<vectorizable T>
+	std::size_t mismatch(const T* left, const T* right, std::size_t n)
+	{
+#ifdef LIST_SIMD_X86
+		if (hasAvx2())
+			return mismatchAvx2(left, right, n);
+		return lanes<T, 16>::mismatch(left, right, n);
+#else
+		return scalar<T>::mismatch(left, right, n);
+#endif
+	}
+}
@@ -0,0 +1,629 @@
+#pragma once
+
+#include<compare>
+#include<cstddef>
+#include<cstdint>
+#include<functional>
+#include<initializer_list>
+#include<iterator>
+#include<limits>
+#include<new>
+#include<stdexcept>
+#include<type_traits>
+#include<utility>
+#include "list.h"
+
+template<class T, std::size_t N>
+class static_list
+{
+	static_assert(N > 0, "static_list needs a capacity of at least one element");
+	static_assert(N < std::numeric_limits<std::uint32_t>::max(), "static_list capacity must fit in 32-bit links");
+
+private:
+	using index_type = std::conditional_t<(N < std::numeric_limits<std::uint16_t>::max()), std::uint16_t, std::uint32_t>;
+	static constexpr index_type npos = std::numeric_limits<index_type>::max();
+	static constexpr index_type sentinel = index_type(N);
+
+	struct slot
+	{
+		index_type previous;
+		index_type next;
+		alignas(T) std::byte storage[sizeof(T)];
+
+		T& value() noexcept { return *std::launder(reinterpret_cast<T*>(storage)); }
+		const T& value() const noexcept { return *std::launder(reinterpret_cast<const T*>(storage)); }
+	};
+
+	slot slots[N + 1];
+	index_type used;
+	index_type freeHead;
+	index_type nelms;
+
+	index_type acquireSlot() noexcept
+	{
+		if (freeHead != npos)
+		{
+			const index_type target = freeHead;
+			freeHead = slots[target].next;
+			return target;
+		}
+		if (used == N)
+			return npos;
+		return used++;
+	}
+
+	void releaseSlot(index_type target) noexcept
+	{
+		slots[target].next = freeHead;
+		freeHead = target;
+	}
+
+	void linkBefore(index_type where, index_type target) noexcept
+	{
+		const index_type before = slots[where].previous;
+		slots[target].previous = before;
+		slots[target].next = where;
+		slots[before].next = target;
+		slots[where].previous = target;
+	}
+
+	template<typename ...Args>
+	index_type tryEmplaceBefore(index_type where, Args&& ...args)
+	{
+		const index_type target = acquireSlot();
+		if (target == npos)
+			return npos;
+
+		try
+		{
+			new (slots[target].storage) T(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			releaseSlot(target);
+			throw;
+		}
+
+		linkBefore(where, target);
+		++nelms;
+		return target;
+	}
+
+	template<typename ...Args>
+	index_type emplaceBefore(index_type where, Args&& ...args)
+	{
+		const index_type target = tryEmplaceBefore(where, std::forward<Args>(args)...);
+		if (target == npos)
+			throw std::length_error("static_list capacity exceeded");
+		return target;
+	}
+
+	void erase(index_type target) noexcept
+	{
+		slots[slots[target].previous].next = slots[target].next;
+		slots[slots[target].next].previous = slots[target].previous;
+		slots[target].value().~T();
+		releaseSlot(target);
+		--nelms;
+	}
+
+	template<class Compare>
+	index_type mergeChains(index_type left, index_type right, Compare& compare)
+	{
+		index_type merged = npos;
+		index_type last = npos;
+
+		auto append = [&](index_type target)
+			{
+				if (last == npos)
+					merged = target;
+				else
+					slots[last].next = target;
+				last = target;
+			};
+
+		while (left != npos && right != npos)
+		{
+			if (compare(slots[right].value(), slots[left].value()))
+			{
+				const index_type next = slots[right].next;
+				append(right);
+				right = next;
+			}
+			else
+			{
+				const index_type next = slots[left].next;
+				append(left);
+				left = next;
+			}
+		}
+
+		append(left != npos ? left : right);
+		return merged;
+	}
+
+	template<bool Const, bool Reverse>
+	class basic_iterator
+	{
+	private:
+		using owner_type = std::conditional_t<Const, const static_list, static_list>;
+
+		owner_type* owner;
+		index_type position;
+
+	public:
+		friend class static_list;
+		template<bool, bool> friend class basic_iterator;
+
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, const T*, T*>;
+		using reference = std::conditional_t<Const, const T&, T&>;
+
+		basic_iterator() : owner(nullptr), position(sentinel) {}
+		basic_iterator(owner_type* owner_, index_type position_) : owner(owner_), position(position_) {}
+
+		template<bool OtherConst, bool OtherReverse>
+			requires (Const || !OtherConst)
+		basic_iterator(const basic_iterator<OtherConst, OtherReverse>& it) : owner(it.owner), position(it.position) {}
+
+		basic_iterator& operator++()
+		{
+			position = Reverse ? owner->slots[position].previous : owner->slots[position].next;
+			return *this;
+		}
+
+		basic_iterator operator++(int)
+		{
+			auto aux = *this;
+			++(*this);
+			return aux;
+		}
+
+		basic_iterator& operator--()
+		{
+			position = Reverse ? owner->slots[position].next : owner->slots[position].previous;
+			return *this;
+		}
+
+		basic_iterator operator--(int)
+		{
+			auto aux = *this;
+			--(*this);
+			return aux;
+		}
+
+		reference operator*() const
+		{
+			if (position == sentinel)
+				throw std::runtime_error("Invalid ptr to use '*' ");
+			return owner->slots[position].value();
+		}
+
+		pointer operator->() const
+		{
+			return &**this;
+		}
+
+		template<bool OtherConst, bool OtherReverse>
+		bool operator==(const basic_iterator<OtherConst, OtherReverse>& it) const noexcept
+		{
+			return position == it.position;
+		}
+	};
+
+public:
+	using iterator = basic_iterator<false, false>;
+	using const_iterator = basic_iterator<true, false>;
+	using reverse_iterator = basic_iterator<false, true>;
+	using const_reverse_iterator = basic_iterator<true, true>;
+
+	static_list() noexcept : used(0), freeHead(npos), nelms(0)
+	{
+		slots[sentinel].previous = sentinel;
+		slots[sentinel].next = sentinel;
+	}
+
+	static_list(const std::initializer_list<T>& ilist) : static_list()
+	{
+		for (const T& e : ilist)
+			push_back(e);
+	}
+
+	static_list(const static_list& other) : static_list()
+	{
+		for (const T& e : other)
+			push_back(e);
+	}
+
+	static_list(static_list&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : static_list()
+	{
+		for (T& e : other)
+			push_back(std::move(e));
+		other.clear();
+	}
+
+	static_list& operator=(const static_list& other)
+	{
+		if (this != &other)
+		{
+			clear();
+			for (const T& e : other)
+				push_back(e);
+		}
+		return *this;
+	}
+
+	static_list& operator=(static_list&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+	{
+		if (this != &other)
+		{
+			clear();
+			for (T& e : other)
+				push_back(std::move(e));
+			other.clear();
+		}
+		return *this;
+	}
+
+	~static_list()
+	{
+		clear();
+	}
+
+	bool operator==(const static_list& other) const noexcept
+	{
+		if (size() != other.size())
+			return false;
+
+		for (index_type a = slots[sentinel].next, b = other.slots[sentinel].next; a != sentinel; a = slots[a].next, b = other.slots[b].next)
+			if (slots[a].value() != other.slots[b].value())
+				return false;
+
+		return true;
+	}
+
+	template <typename... Args>
+	[[nodiscard]] bool try_emplace_back(Args &&...args)
+	{
+		return tryEmplaceBefore(sentinel, std::forward<Args>(args)...) != npos;
+	}
+
+	template <typename... Args>
+	[[nodiscard]] bool try_emplace_front(Args &&...args)
+	{
+		return tryEmplaceBefore(slots[sentinel].next, std::forward<Args>(args)...) != npos;
+	}
+
+	template <typename... Args>
+	void emplace_back(Args &&...args)
+	{
+		emplaceBefore(sentinel, std::forward<Args>(args)...);
+	}
+
+	void push_back(const T& newvalue)
+	{
+		emplace_back(newvalue);
+	}
+
+	void push_back(T&& newvalue)
+	{
+		emplace_back(std::move(newvalue));
+	}
+
+	template<typename... Args>
+	void emplace_front(Args&& ...args)
+	{
+		emplaceBefore(slots[sentinel].next, std::forward<Args>(args)...);
+	}
+
+	void push_front(const T& newvalue)
+	{
+		emplace_front(newvalue);
+	}
+
+	void push_front(T&& newvalue)
+	{
+		emplace_front(std::move(newvalue));
+	}
+
+	void pop_back()
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		erase(slots[sentinel].previous);
+	}
+
+	void pop_front()
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		erase(slots[sentinel].next);
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept
+	{
+		return nelms;
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return nelms == 0;
+	}
+
+	[[nodiscard]] bool full() const noexcept
+	{
+		return nelms == N;
+	}
+
+	[[nodiscard]] static constexpr std::size_t capacity() noexcept
+	{
+		return N;
+	}
+
+	T& front()
+	{
+		if (empty())
+			throw std::length_error("front called on empty list");
+		return slots[slots[sentinel].next].value();
+	}
+
+	T& back()
+	{
+		if (empty())
+			throw std::length_error("back called on empty list");
+		return slots[slots[sentinel].previous].value();
+	}
+
+	const T& front() const
+	{
+		if (empty())
+			throw std::length_error("front called on empty list");
+		return slots[slots[sentinel].next].value();
+	}
+
+	const T& back() const
+	{
+		if (empty())
+			throw std::length_error("back called on empty list");
+		return slots[slots[sentinel].previous].value();
+	}
+
+	void clear() noexcept
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+			for (index_type i = slots[sentinel].next; i != sentinel; i = slots[i].next)
+				slots[i].value().~T();
+
+		slots[sentinel].previous = sentinel;
+		slots[sentinel].next = sentinel;
+		used = 0;
+		freeHead = npos;
+		nelms = 0;
+	}
+
+	[[nodiscard]] iterator begin() noexcept { return { this, slots[sentinel].next }; }
+	[[nodiscard]] iterator end() noexcept { return { this, sentinel }; }
+	[[nodiscard]] const_iterator begin() const noexcept { return { this, slots[sentinel].next }; }
+	[[nodiscard]] const_iterator end() const noexcept { return { this, sentinel }; }
+	[[nodiscard]] const_iterator cbegin() const noexcept { return { this, slots[sentinel].next }; }
+	[[nodiscard]] const_iterator cend() const noexcept { return { this, sentinel }; }
+	[[nodiscard]] reverse_iterator rbegin() noexcept { return { this, slots[sentinel].previous }; }
+	[[nodiscard]] reverse_iterator rend() noexcept { return { this, sentinel }; }
+	[[nodiscard]] const_reverse_iterator crbegin() const noexcept { return { this, slots[sentinel].previous }; }
+	[[nodiscard]] const_reverse_iterator crend() const noexcept { return { this, sentinel }; }
+
+	template<typename It, typename ...Args>
+		requires is_valid_iterator<static_list, It>::iteratorConcept
+	std::pair<It, bool> try_emplace(It it, Args&& ... args)
+	{
+		const index_type target = tryEmplaceBefore(it.position, std::forward<Args>(args)...);
+		if (target == npos)
+			return { it, false };
+		return { It(this, target), true };
+	}
+
+	template<typename It>
+		requires is_valid_iterator<static_list, It>::iteratorConcept
+	std::pair<It, bool> try_insert(It it, const T& newvalue)
+	{
+		return try_emplace<It>(it, newvalue);
+	}
+
+	template<typename It>
+		requires is_valid_iterator<static_list, It>::iteratorConcept
+	std::pair<It, bool> try_insert(It it, T&& newvalue)
+	{
+		return try_emplace<It>(it, std::move(newvalue));
+	}
+
+	template<typename It, typename ...Args>
+		requires is_valid_iterator<static_list, It>::iteratorConcept
+	It emplace(It it, Args&& ... args)
+	{
+		return It(this, emplaceBefore(it.position, std::forward<Args>(args)...));
+	}
+
+	template<typename It>
+		requires is_valid_iterator<static_list, It>::iteratorConcept
+	It insert(It it, const T& newvalue)
+	{
+		return emplace<It>(it, newvalue);
+	}
+
+	template<typename It>
+		requires is_valid_iterator<static_list, It>::iteratorConcept
+	It insert(It it, T&& newvalue)
+	{
+		return emplace<It>(it, std::move(newvalue));
+	}
+
+	template<typename It>
+		requires is_valid_iterator<static_list, It>::iteratorConcept
+	It pop(It it)
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		if (it.position == sentinel)
+			throw std::runtime_error("pop called on head");
+		const index_type next = slots[it.position].next;
+		erase(it.position);
+		return It(this, next);
+	}
+
+	template<class NoReverseIT>
+		requires std::same_as<NoReverseIT, iterator> || std::same_as<NoReverseIT, const_iterator>
+	NoReverseIT erase(NoReverseIT first, NoReverseIT last)
+	{
+		for (index_type i = first.position; i != last.position; i = slots[i].next)
+			if (i == sentinel)
+				throw std::runtime_error("erase range contains head");
+
+		for (index_type i = first.position; i != last.position;)
+		{
+			const index_type next = slots[i].next;
+			erase(i);
+			i = next;
+		}
+
+		return last;
+	}
+
+	template<typename It>
+		requires is_valid_iterator<static_list, It>::iteratorConcept
+	void splice(It where, static_list& rightlist)
+	{
+		if (rightlist.empty() || &rightlist == this)
+			return;
+		if (size() + rightlist.size() > N)
+			throw std::length_error("static_list capacity exceeded");
+
+		const index_type before = slots[where.position].next;
+		for (index_type i = rightlist.slots[sentinel].next; i != sentinel; i = rightlist.slots[i].next)
+			emplaceBefore(before, std::move(rightlist.slots[i].value()));
+		rightlist.clear();
+	}
+
+	template<class Condition>
+	std::size_t remove_if(Condition condition)
+	{
+		const std::size_t before = nelms;
+		for (index_type i = slots[sentinel].next; i != sentinel;)
+		{
+			const index_type next = slots[i].next;
+			if (condition(std::as_const(slots[i].value())))
+				erase(i);
+			i = next;
+		}
+		return before - nelms;
+	}
+
+	template<class Compare = std::less<>>
+	void sort(Compare compare = {})
+	{
+		if (nelms < 2)
+			return;
+
+		slots[slots[sentinel].previous].next = npos;
+		index_type bins[std::numeric_limits<index_type>::digits + 1];
+		std::size_t usedBins = 0;
+
+		for (index_type aux = slots[sentinel].next; aux != npos;)
+		{
+			index_type carry = aux;
+			aux = slots[aux].next;
+			slots[carry].next = npos;
+
+			std::size_t i = 0;
+			for (; i < usedBins && bins[i] != npos; i++)
+			{
+				carry = mergeChains(bins[i], carry, compare);
+				bins[i] = npos;
+			}
+
+			bins[i] = carry;
+			if (i == usedBins)
+				++usedBins;
+		}
+
+		index_type result = npos;
+		for (std::size_t i = 0; i < usedBins; i++)
+			if (bins[i] != npos)
+				result = result == npos ? bins[i] : mergeChains(bins[i], result, compare);
+
+		index_type previous = sentinel;
+		for (index_type i = result; i != npos; i = slots[i].next)
+		{
+			slots[previous].next = i;
+			slots[i].previous = previous;
+			previous = i;
+		}
+		slots[previous].next = sentinel;
+		slots[sentinel].previous = previous;
+	}
+
+	template<class Function>
+	Function for_each(Function function)
+	{
+		for (index_type i = slots[sentinel].next; i != sentinel; i = slots[i].next)
+			function(slots[i].value());
+		return function;
+	}
+
+	template<class Function>
+	Function for_each(Function function) const
+	{
+		for (index_type i = slots[sentinel].next; i != sentinel; i = slots[i].next)
+			function(slots[i].value());
+		return function;
+	}
+
+	template<class Condition>
+	[[nodiscard]] iterator find_if(Condition condition)
+	{
+		index_type i = slots[sentinel].next;
+		while (i != sentinel && !condition(std::as_const(slots[i].value())))
+			i = slots[i].next;
+		return { this, i };
+	}
+
+	template<class Condition>
+	[[nodiscard]] const_iterator find_if(Condition condition) const
+	{
+		index_type i = slots[sentinel].next;
+		while (i != sentinel && !condition(slots[i].value()))
+			i = slots[i].next;
+		return { this, i };
+	}
+
+	[[nodiscard]] iterator find(const T& target)
+	{
+		return find_if([&](const T& value) { return value == target; });
+	}
+
+	[[nodiscard]] const_iterator find(const T& target) const
+	{
+		return find_if([&](const T& value) { return value == target; });
+	}
+
+	[[nodiscard]] bool contains(const T& target) const
+	{
+		return find(target) != cend();
+	}
+
+	template<class Condition>
+	[[nodiscard]] std::size_t count_if(Condition condition) const
+	{
+		std::size_t total = 0;
+		for_each([&](const T& value) { total += bool(condition(value)); });
+		return total;
+	}
+
+	template<typename U, class BinaryOperation = std::plus<>>
+	[[nodiscard]] U accumulate(U init, BinaryOperation operation = {}) const
+	{
+		for_each([&](const T& value) { init = operation(std::move(init), value); });
+		return init;
+	}
+};
@@ -0,0 +1,565 @@
+#pragma once
+
+#include<cstddef>
+#include<cstdint>
+#include<deque>
+#include<filesystem>
+#include<fstream>
+#include<functional>
+#include<iterator>
+#include<memory>
+#include<optional>
+#include<sstream>
+#include<stdexcept>
+#include<string>
+#include<system_error>
+#include<type_traits>
+#include<utility>
+#include<vector>
+#include "list.h"
+#include "serialization.h"
+
+struct tiered_list_options
+{
+	std::size_t segment_elements = 4096;
+	std::size_t max_resident_segments = 16;
+	std::size_t hot_segments = 1;
+};
+
+struct tiered_list_stats
+{
+	std::size_t page_ins = 0;
+	std::size_t page_outs = 0;
+	std::size_t bytes_read = 0;
+	std::size_t bytes_written = 0;
+	std::size_t resident_segments = 0;
+	std::size_t segments = 0;
+	std::size_t spill_bytes = 0;
+	std::size_t stale_bytes = 0;
+};
+
+template<class T>
+class tiered_list
+{
+private:
+	static constexpr std::size_t no_segment = ~std::size_t(0);
+
+	struct segment
+	{
+		list<T> values;
+		std::size_t count = 0;
+		bool resident = true;
+		bool dirty = true;
+		std::uint64_t fileOffset = 0;
+		std::uint64_t fileBytes = 0;
+		std::uint64_t fileCapacity = 0;
+		std::size_t fileDigest = 0;
+		std::uint64_t lastUse = 0;
+		std::uint64_t generation = 0;
+	};
+
+	tiered_list_options options;
+	std::filesystem::path spillPath;
+	mutable std::fstream spill;
+	mutable std::deque<std::unique_ptr<segment>> segments;
+	mutable tiered_list_stats counters;
+	mutable std::uint64_t clock;
+	std::size_t nelms;
+
+	bool isHot(std::size_t index) const noexcept
+	{
+		return index < options.hot_segments || index + options.hot_segments >= segments.size();
+	}
+
+	bool matchesExtent(const segment& target, const std::string& encoded, std::size_t digest) const
+	{
+		if (target.fileCapacity == 0 || encoded.size() != target.fileBytes || digest != target.fileDigest)
+			return false;
+
+		std::string stored(encoded.size(), '\0');
+		spill.clear();
+		spill.seekg(static_cast<std::streamoff>(target.fileOffset));
+		spill.read(stored.data(), static_cast<std::streamsize>(stored.size()));
+		counters.bytes_read += stored.size();
+		return spill && stored == encoded;
+	}
+
+	void writeExtent(segment& target, const std::string& encoded, std::size_t digest) const
+	{
+		spill.clear();
+		if (encoded.size() <= target.fileCapacity)
+			spill.seekp(static_cast<std::streamoff>(target.fileOffset));
+		else
+		{
+			counters.stale_bytes += static_cast<std::size_t>(target.fileCapacity);
+			target.fileOffset = counters.spill_bytes;
+			target.fileCapacity = encoded.size();
+			counters.spill_bytes += encoded.size();
+			spill.seekp(static_cast<std::streamoff>(target.fileOffset));
+		}
+		if (!spill.write(encoded.data(), static_cast<std::streamsize>(encoded.size())) || !spill.flush())
+			throw std::runtime_error("tiered_list could not write spill file " + spillPath.string());
+
+		target.fileBytes = encoded.size();
+		target.fileDigest = digest;
+		counters.bytes_written += encoded.size();
+	}
+
+	void compact() const
+	{
+		std::filesystem::path compactedPath = spillPath;
+		compactedPath += ".compact";
+		std::fstream compacted(compactedPath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!compacted)
+			throw std::runtime_error("tiered_list could not create spill file " + compactedPath.string());
+
+		std::vector<std::uint64_t> offsets(segments.size());
+		std::uint64_t end = 0;
+		std::string bytes;
+		for (std::size_t i = 0; i < segments.size(); i++)
+		{
+			const segment& current = *segments[i];
+			if (current.fileCapacity == 0)
+				continue;
+			bytes.resize(static_cast<std::size_t>(current.fileBytes));
+			spill.clear();
+			spill.seekg(static_cast<std::streamoff>(current.fileOffset));
+			spill.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+			compacted.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+			offsets[i] = end;
+			end += current.fileBytes;
+		}
+		if (!spill || !compacted.flush())
+		{
+			compacted.close();
+			std::error_code ignored;
+			std::filesystem::remove(compactedPath, ignored);
+			throw std::runtime_error("tiered_list could not compact spill file " + spillPath.string());
+		}
+
+		compacted.close();
+		spill.close();
+		std::filesystem::rename(compactedPath, spillPath);
+		spill.open(spillPath, std::ios::in | std::ios::out | std::ios::binary);
+		if (!spill)
+			throw std::runtime_error("tiered_list could not reopen spill file " + spillPath.string());
+
+		for (std::size_t i = 0; i < segments.size(); i++)
+		{
+			segment& current = *segments[i];
+			if (current.fileCapacity == 0)
+				continue;
+			current.fileOffset = offsets[i];
+			current.fileCapacity = current.fileBytes;
+		}
+		counters.spill_bytes = static_cast<std::size_t>(end);
+		counters.stale_bytes = 0;
+	}
+
+	void pageOut(segment& target) const
+	{
+		if (target.dirty)
+		{
+			std::ostringstream buffer;
+			{
+				list_io::writer out(buffer);
+				list_io::codec<T> encoder;
+				target.values.for_each([&](const T& value) { encoder.encode(out, value); });
+				out.flush();
+			}
+			const std::string encoded = std::move(buffer).str();
+			const std::size_t digest = std::hash<std::string>{}(encoded);
+			if (!matchesExtent(target, encoded, digest))
+				writeExtent(target, encoded, digest);
+			target.dirty = false;
+			if (counters.stale_bytes * 2 > counters.spill_bytes)
+				compact();
+		}
+
+		target.values.clear();
+		target.resident = false;
+		--counters.resident_segments;
+		++counters.page_outs;
+	}
+
+	void pageIn(segment& target) const
+	{
+		spill.clear();
+		spill.seekg(static_cast<std::streamoff>(target.fileOffset));
+		{
+			list_io::reader in(spill, static_cast<std::size_t>(std::min<std::uint64_t>(target.fileBytes + 1, list_io::buffer_bytes)));
+			list_io::codec<T> decoder;
+			target.values.append_n(target.count, [&] { return decoder.decode(in); });
+		}
+		target.resident = true;
+		++target.generation;
+		++counters.resident_segments;
+		++counters.page_ins;
+		counters.bytes_read += static_cast<std::size_t>(target.fileBytes);
+	}
+
+	void enforceLimit(std::size_t pinned) const
+	{
+		while (counters.resident_segments > options.max_resident_segments)
+		{
+			std::size_t victim = no_segment;
+			for (std::size_t i = options.hot_segments; i + options.hot_segments < segments.size(); i++)
+			{
+				const segment& candidate = *segments[i];
+				if (candidate.resident && i != pinned && (victim == no_segment || candidate.lastUse < segments[victim]->lastUse))
+					victim = i;
+			}
+			if (victim == no_segment)
+				return;
+			pageOut(*segments[victim]);
+		}
+	}
+
+	segment& touch(std::size_t index) const
+	{
+		segment& target = *segments[index];
+		target.lastUse = ++clock;
+		if (!target.resident)
+		{
+			pageIn(target);
+			enforceLimit(index);
+		}
+		return target;
+	}
+
+	segment& addSegment(bool atFront)
+	{
+		auto fresh = std::make_unique<segment>();
+		segment& added = *fresh;
+		if (atFront)
+			segments.push_front(std::move(fresh));
+		else
+			segments.push_back(std::move(fresh));
+		++counters.resident_segments;
+		++counters.segments;
+		added.lastUse = ++clock;
+		return added;
+	}
+
+	void dropSegment(bool atFront)
+	{
+		if (segments.empty())
+			return;
+		segment& target = atFront ? *segments.front() : *segments.back();
+		if (target.count != 0)
+			return;
+
+		if (target.resident)
+			--counters.resident_segments;
+		--counters.segments;
+		counters.stale_bytes += static_cast<std::size_t>(target.fileCapacity);
+		if (atFront)
+			segments.pop_front();
+		else
+			segments.pop_back();
+
+		for (std::size_t i = 0; i < segments.size(); i++)
+			if (isHot(i))
+				touch(i);
+	}
+
+	segment& frontSegment() const
+	{
+		if (nelms == 0)
+			throw std::length_error("front called on empty list");
+		return touch(0);
+	}
+
+	segment& backSegment() const
+	{
+		if (nelms == 0)
+			throw std::length_error("back called on empty list");
+		return touch(segments.size() - 1);
+	}
+
+	template<bool Const>
+	class basic_iterator
+	{
+	private:
+		using inner = std::conditional_t<Const, typename list<T>::const_iterator, typename list<T>::iterator>;
+		using owner_type = std::conditional_t<Const, const tiered_list, tiered_list>;
+
+		owner_type* owner;
+		std::size_t index;
+		std::size_t offset;
+		mutable std::optional<inner> position;
+		mutable std::uint64_t generation;
+
+		segment& resolve() const
+		{
+			segment& current = owner->touch(index);
+			if (!position || generation != current.generation)
+			{
+				position.emplace(std::next(current.values.begin(), std::ptrdiff_t(offset)));
+				generation = current.generation;
+			}
+			if constexpr (!Const)
+				current.dirty = true;
+			return current;
+		}
+
+		void settle()
+		{
+			while (index < owner->segments.size() && offset == owner->segments[index]->count)
+			{
+				++index;
+				offset = 0;
+				position.reset();
+			}
+		}
+
+	public:
+		friend class tiered_list;
+		template<bool> friend class basic_iterator;
+
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, const T*, T*>;
+		using reference = std::conditional_t<Const, const T&, T&>;
+
+		basic_iterator() : owner(nullptr), index(0), offset(0), generation(0) {}
+
+		basic_iterator(owner_type* owner_, std::size_t index_) : owner(owner_), index(index_), offset(0), generation(0)
+		{
+			settle();
+		}
+
+		basic_iterator& operator++()
+		{
+			if (position && generation == owner->segments[index]->generation && owner->segments[index]->resident)
+				++*position;
+			++offset;
+			settle();
+			return *this;
+		}
+
+		basic_iterator operator++(int)
+		{
+			auto aux = *this;
+			++(*this);
+			return aux;
+		}
+
+		reference operator*() const
+		{
+			if (!owner || index >= owner->segments.size())
+				throw std::runtime_error("Invalid ptr to use '*' ");
+			resolve();
+			return **position;
+		}
+
+		pointer operator->() const
+		{
+			return &**this;
+		}
+
+		bool operator==(const basic_iterator& it) const
+		{
+			return index == it.index && offset == it.offset;
+		}
+	};
+
+public:
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
+	explicit tiered_list(const std::filesystem::path& spill_file, tiered_list_options options_ = {})
+		: options(options_), spillPath(spill_file), clock(0), nelms(0)
+	{
+		if (options.segment_elements == 0 || options.hot_segments == 0)
+			throw std::invalid_argument("tiered_list segments and hot segments must be positive");
+		if (options.max_resident_segments < 2 * options.hot_segments + 1)
+			throw std::invalid_argument("tiered_list must keep at least one interior segment resident");
+
+		spill.open(spillPath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!spill)
+			throw std::runtime_error("tiered_list could not create spill file " + spillPath.string());
+	}
+
+	tiered_list(const tiered_list&) = delete;
+	tiered_list& operator=(const tiered_list&) = delete;
+
+	~tiered_list()
+	{
+		spill.close();
+		std::error_code ignored;
+		std::filesystem::remove(spillPath, ignored);
+	}
+
+	template <typename... Args>
+	void emplace_back(Args &&...args)
+	{
+		segment* target = segments.empty() ? nullptr : &touch(segments.size() - 1);
+		if (!target || target->count == options.segment_elements)
+			target = &addSegment(false);
+
+		target->values.emplace_back(std::forward<Args>(args)...);
+		target->dirty = true;
+		++target->count;
+		++nelms;
+		enforceLimit(segments.size() - 1);
+	}
+
+	void push_back(const T& newvalue)
+	{
+		emplace_back(newvalue);
+	}
+
+	void push_back(T&& newvalue)
+	{
+		emplace_back(std::move(newvalue));
+	}
+
+	template <typename... Args>
+	void emplace_front(Args &&...args)
+	{
+		segment* target = segments.empty() ? nullptr : &touch(0);
+		if (!target || target->count == options.segment_elements)
+			target = &addSegment(true);
+
+		target->values.emplace_front(std::forward<Args>(args)...);
+		target->dirty = true;
+		++target->count;
+		++nelms;
+		enforceLimit(0);
+	}
+
+	void push_front(const T& newvalue)
+	{
+		emplace_front(newvalue);
+	}
+
+	void push_front(T&& newvalue)
+	{
+		emplace_front(std::move(newvalue));
+	}
+
+	void pop_front()
+	{
+		if (nelms == 0)
+			throw std::length_error("pop called on empty list");
+		segment& target = touch(0);
+		target.values.pop_front();
+		target.dirty = true;
+		--target.count;
+		--nelms;
+		dropSegment(true);
+	}
+
+	void pop_back()
+	{
+		if (nelms == 0)
+			throw std::length_error("pop called on empty list");
+		segment& target = touch(segments.size() - 1);
+		target.values.pop_back();
+		target.dirty = true;
+		--target.count;
+		--nelms;
+		dropSegment(false);
+	}
+
+	T& front()
+	{
+		segment& target = frontSegment();
+		target.dirty = true;
+		return target.values.front();
+	}
+
+	T& back()
+	{
+		segment& target = backSegment();
+		target.dirty = true;
+		return target.values.back();
+	}
+
+	const T& front() const
+	{
+		return std::as_const(frontSegment().values).front();
+	}
+
+	const T& back() const
+	{
+		return std::as_const(backSegment().values).back();
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept
+	{
+		return nelms;
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return nelms == 0;
+	}
+
+	void clear()
+	{
+		segments.clear();
+		counters.resident_segments = 0;
+		counters.segments = 0;
+		counters.spill_bytes = 0;
+		counters.stale_bytes = 0;
+		nelms = 0;
+		spill.close();
+		spill.open(spillPath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!spill)
+			throw std::runtime_error("tiered_list could not recreate spill file " + spillPath.string());
+	}
+
+	[[nodiscard]] const tiered_list_stats& stats() const noexcept
+	{
+		return counters;
+	}
+
+	void reset_stats() noexcept
+	{
+		counters.page_ins = 0;
+		counters.page_outs = 0;
+		counters.bytes_read = 0;
+		counters.bytes_written = 0;
+	}
+
+	[[nodiscard]] iterator begin() { return iterator(this, 0); }
+	[[nodiscard]] iterator end() { return iterator(this, segments.size()); }
+	[[nodiscard]] const_iterator begin() const { return const_iterator(this, 0); }
+	[[nodiscard]] const_iterator end() const { return const_iterator(this, segments.size()); }
+	[[nodiscard]] const_iterator cbegin() const { return begin(); }
+	[[nodiscard]] const_iterator cend() const { return end(); }
+
+	template<class Function>
+	Function for_each(Function function) const
+	{
+		for (std::size_t i = 0; i < segments.size(); i++)
+			touch(i).values.for_each([&](const T& value) { function(value); });
+		return function;
+	}
+
+	template<class Condition>
+	[[nodiscard]] std::size_t count_if(Condition condition) const
+	{
+		std::size_t total = 0;
+		for_each([&](const T& value) { total += bool(condition(value)); });
+		return total;
+	}
+
+	[[nodiscard]] bool contains(const T& target) const
+	{
+		for (std::size_t i = 0; i < segments.size(); i++)
+			if (touch(i).values.contains(target))
+				return true;
+		return false;
+	}
+
+	template<typename U, class BinaryOperation = std::plus<>>
+	[[nodiscard]] U accumulate(U init, BinaryOperation operation = {}) const
+	{
+		for_each([&](const T& value) { init = operation(std::move(init), value); });
+		return init;
+	}
+};
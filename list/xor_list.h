@@ -0,0 +1,469 @@
+#pragma once
+
+#include<cstddef>
+#include<cstdint>
+#include<functional>
+#include<initializer_list>
+#include<iterator>
+#include<stdexcept>
+#include<type_traits>
+#include<utility>
+#include "list.h"
+
+template<class T>
+class xor_list
+{
+private:
+	struct node
+	{
+		std::uintptr_t both;
+		T value;
+
+		template<typename... Args>
+		node(std::uintptr_t both_, Args&&...args)
+			: both(both_), value(std::forward<Args>(args)...) {}
+	};
+
+	node* first;
+	node* last;
+	std::size_t nelms;
+
+	static std::uintptr_t address(const node* target) noexcept
+	{
+		return reinterpret_cast<std::uintptr_t>(target);
+	}
+
+	static node* other(const node* at, const node* neighbor) noexcept
+	{
+		return reinterpret_cast<node*>(at->both ^ address(neighbor));
+	}
+
+	void linkBetween(node* before, node* after, node* chainFirst, node* chainLast) noexcept
+	{
+		chainFirst->both ^= address(before);
+		chainLast->both ^= address(after);
+
+		if (before)
+			before->both ^= address(after) ^ address(chainFirst);
+		else
+			first = chainFirst;
+
+		if (after)
+			after->both ^= address(before) ^ address(chainLast);
+		else
+			last = chainLast;
+	}
+
+	void unlinkBetween(node* before, node* target, node* after) noexcept
+	{
+		if (before)
+			before->both ^= address(target) ^ address(after);
+		else
+			first = after;
+
+		if (after)
+			after->both ^= address(target) ^ address(before);
+		else
+			last = before;
+	}
+
+	void deepCopy(const xor_list& other)
+	{
+		for (const T& e : other)
+			push_back(e);
+	}
+
+	template<bool Const, bool Reverse>
+	class basic_iterator
+	{
+	private:
+		node* from;
+		node* current;
+
+	public:
+		friend class xor_list;
+		template<bool, bool> friend class basic_iterator;
+		static constexpr bool reversed = Reverse;
+
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, const T*, T*>;
+		using reference = std::conditional_t<Const, const T&, T&>;
+
+		basic_iterator() : from(nullptr), current(nullptr) {}
+		basic_iterator(node* from_, node* current_) : from(from_), current(current_) {}
+
+		template<bool OtherConst>
+			requires (Const || !OtherConst)
+		basic_iterator(const basic_iterator<OtherConst, Reverse>& it) : from(it.from), current(it.current) {}
+
+
+		basic_iterator& operator++()
+		{
+			node* next = other(current, from);
+			from = current;
+			current = next;
+			return *this;
+		}
+
+		basic_iterator operator++(int)
+		{
+			auto aux = *this;
+			++(*this);
+			return aux;
+		}
+
+		basic_iterator& operator--()
+		{
+			node* previous = other(from, current);
+			current = from;
+			from = previous;
+			return *this;
+		}
+
+		basic_iterator operator--(int)
+		{
+			auto aux = *this;
+			--(*this);
+			return aux;
+		}
+
+		reference operator*() const
+		{
+			if (!current)
+				throw std::runtime_error("Invalid ptr to use '*' ");
+			return current->value;
+		}
+
+		pointer operator->() const
+		{
+			return &**this;
+		}
+
+		template<bool OtherConst>
+		bool operator==(const basic_iterator<OtherConst, Reverse>& it) const noexcept
+		{
+			return current == it.current && from == it.from;
+		}
+	};
+
+public:
+	using iterator = basic_iterator<false, false>;
+	using const_iterator = basic_iterator<true, false>;
+	using reverse_iterator = basic_iterator<false, true>;
+	using const_reverse_iterator = basic_iterator<true, true>;
+
+	xor_list() : first(nullptr), last(nullptr), nelms(0) {}
+
+	xor_list(const std::initializer_list<T>& ilist) : xor_list()
+	{
+		for (const T& e : ilist)
+			push_back(e);
+	}
+
+	xor_list(const xor_list& other) : xor_list()
+	{
+		deepCopy(other);
+	}
+
+	xor_list(xor_list&& other) noexcept
+		: first(std::exchange(other.first, nullptr)),
+		last(std::exchange(other.last, nullptr)),
+		nelms(std::exchange(other.nelms, 0)) {}
+
+	xor_list& operator=(const xor_list& other)
+	{
+		if (this != &other)
+		{
+			clear();
+			deepCopy(other);
+		}
+		return *this;
+	}
+
+	xor_list& operator=(xor_list&& other) noexcept
+	{
+		if (this != &other)
+		{
+			clear();
+			first = std::exchange(other.first, nullptr);
+			last = std::exchange(other.last, nullptr);
+			nelms = std::exchange(other.nelms, 0);
+		}
+		return *this;
+	}
+
+	~xor_list()
+	{
+		clear();
+	}
+
+	bool operator==(const xor_list& other) const noexcept
+	{
+		if (size() != other.size())
+			return false;
+
+		auto it = other.begin();
+		for (const T& e : *this)
+		{
+			if (e != *it)
+				return false;
+			++it;
+		}
+		return true;
+	}
+
+	template <typename... Args>
+	void emplace_back(Args &&...args)
+	{
+		node* newnode = new node(0, std::forward<Args>(args)...);
+		linkBetween(last, nullptr, newnode, newnode);
+		++nelms;
+	}
+
+	void push_back(const T& newvalue)
+	{
+		emplace_back(newvalue);
+	}
+
+	void push_back(T&& newvalue)
+	{
+		emplace_back(std::move(newvalue));
+	}
+
+	template <typename... Args>
+	void emplace_front(Args &&...args)
+	{
+		node* newnode = new node(0, std::forward<Args>(args)...);
+		linkBetween(nullptr, first, newnode, newnode);
+		++nelms;
+	}
+
+	void push_front(const T& newvalue)
+	{
+		emplace_front(newvalue);
+	}
+
+	void push_front(T&& newvalue)
+	{
+		emplace_front(std::move(newvalue));
+	}
+
+	void pop_back()
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		node* target = last;
+		unlinkBetween(other(target, nullptr), target, nullptr);
+		delete target;
+		--nelms;
+	}
+
+	void pop_front()
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		node* target = first;
+		unlinkBetween(nullptr, target, other(target, nullptr));
+		delete target;
+		--nelms;
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept
+	{
+		return nelms;
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return nelms == 0;
+	}
+
+	T& front()
+	{
+		if (empty())
+			throw std::length_error("front called on empty list");
+		return first->value;
+	}
+
+	T& back()
+	{
+		if (empty())
+			throw std::length_error("back called on empty list");
+		return last->value;
+	}
+
+	const T& front() const
+	{
+		if (empty())
+			throw std::length_error("front called on empty list");
+		return first->value;
+	}
+
+	const T& back() const
+	{
+		if (empty())
+			throw std::length_error("back called on empty list");
+		return last->value;
+	}
+
+	void clear()
+	{
+		node* from = nullptr;
+		node* current = first;
+		while (current)
+		{
+			node* next = other(current, from);
+			from = current;
+			delete current;
+			current = next;
+		}
+
+		first = nullptr;
+		last = nullptr;
+		nelms = 0;
+	}
+
+	[[nodiscard]] iterator begin() noexcept { return { nullptr, first }; }
+	[[nodiscard]] iterator end() noexcept { return { last, nullptr }; }
+	[[nodiscard]] const_iterator begin() const noexcept { return { nullptr, first }; }
+	[[nodiscard]] const_iterator end() const noexcept { return { last, nullptr }; }
+	[[nodiscard]] const_iterator cbegin() const noexcept { return { nullptr, first }; }
+	[[nodiscard]] const_iterator cend() const noexcept { return { last, nullptr }; }
+	[[nodiscard]] reverse_iterator rbegin() noexcept { return { nullptr, last }; }
+	[[nodiscard]] reverse_iterator rend() noexcept { return { first, nullptr }; }
+	[[nodiscard]] const_reverse_iterator crbegin() const noexcept { return { nullptr, last }; }
+	[[nodiscard]] const_reverse_iterator crend() const noexcept { return { first, nullptr }; }
+
+	template<typename It, typename ...Args>
+		requires is_valid_iterator<xor_list, It>::iteratorConcept
+	It emplace(It it, Args&& ... args)
+	{
+		node* newnode = new node(0, std::forward<Args>(args)...);
+		if constexpr (It::reversed)
+			linkBetween(it.current, it.from, newnode, newnode);
+		else
+			linkBetween(it.from, it.current, newnode, newnode);
+		++nelms;
+		return It(it.from, newnode);
+	}
+
+	template<typename It>
+		requires is_valid_iterator<xor_list, It>::iteratorConcept
+	It insert(It it, const T& newvalue)
+	{
+		return emplace<It>(it, newvalue);
+	}
+
+	template<typename It>
+		requires is_valid_iterator<xor_list, It>::iteratorConcept
+	It insert(It it, T&& newvalue)
+	{
+		return emplace<It>(it, std::move(newvalue));
+	}
+
+	template<typename It>
+		requires is_valid_iterator<xor_list, It>::iteratorConcept
+	It pop(It it)
+	{
+		if (empty())
+			throw std::length_error("pop called on empty list");
+		if (!it.current)
+			throw std::runtime_error("pop called on head");
+		node* next = other(it.current, it.from);
+		if constexpr (It::reversed)
+			unlinkBetween(next, it.current, it.from);
+		else
+			unlinkBetween(it.from, it.current, next);
+		delete it.current;
+		--nelms;
+		return It(it.from, next);
+	}
+
+	template<typename It>
+		requires is_valid_iterator<xor_list, It>::iteratorConcept
+	void splice(It where, xor_list& rightlist)
+	{
+		if (rightlist.empty() || &rightlist == this)
+			return;
+
+		if (!where.current)
+			linkBetween(nullptr, first, rightlist.first, rightlist.last);
+		else if constexpr (It::reversed)
+			linkBetween(where.current, where.from, rightlist.first, rightlist.last);
+		else
+			linkBetween(where.current, other(where.current, where.from), rightlist.first, rightlist.last);
+
+		nelms += rightlist.nelms;
+		rightlist.first = nullptr;
+		rightlist.last = nullptr;
+		rightlist.nelms = 0;
+	}
+
+	template<class Function>
+	Function for_each(Function function)
+	{
+		node* from = nullptr;
+		for (node* current = first; current;)
+		{
+			function(current->value);
+			node* next = other(current, from);
+			from = current;
+			current = next;
+		}
+		return function;
+	}
+
+	template<class Function>
+	Function for_each(Function function) const
+	{
+		const_cast<xor_list*>(this)->for_each([&](T& value) { function(std::as_const(value)); });
+		return function;
+	}
+
+	template<class Condition>
+	[[nodiscard]] iterator find_if(Condition condition)
+	{
+		iterator it = begin();
+		while (it.current && !condition(std::as_const(it.current->value)))
+			++it;
+		return it;
+	}
+
+	template<class Condition>
+	[[nodiscard]] const_iterator find_if(Condition condition) const
+	{
+		return const_cast<xor_list*>(this)->find_if(condition);
+	}
+
+	[[nodiscard]] iterator find(const T& target)
+	{
+		return find_if([&](const T& value) { return value == target; });
+	}
+
+	[[nodiscard]] const_iterator find(const T& target) const
+	{
+		return find_if([&](const T& value) { return value == target; });
+	}
+
+	[[nodiscard]] bool contains(const T& target) const
+	{
+		return find(target) != cend();
+	}
+
+	template<class Condition>
+	[[nodiscard]] std::size_t count_if(Condition condition) const
+	{
+		std::size_t total = 0;
+		for_each([&](const T& value) { total += bool(condition(value)); });
+		return total;
+	}
+
+	template<typename U, class BinaryOperation = std::plus<>>
+	[[nodiscard]] U accumulate(U init, BinaryOperation operation = {}) const
+	{
+		for_each([&](const T& value) { init = operation(std::move(init), value); });
+		return init;
+	}
+};
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include "../list/annotated_list.h"
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using sumlist = annotated_list<long long, list_monoid::sum<long long>>;
+using summarylist = annotated_list<int, list_monoid::summary<int>>;
+
+namespace
+{
+	struct concat
+	{
+		using value_type = std::string;
+
+		value_type identity() const { return {}; }
+		value_type measure(char value) const { return std::string(1, value); }
+		value_type combine(const value_type& left, const value_type& right) const { return left + right; }
+	};
+
+	summarylist::summary_type bruteForce(const std::vector<int>& values, std::size_t first, std::size_t last)
+	{
+		list_monoid::summary<int> monoid;
+		summarylist::summary_type result = monoid.identity();
+		for (std::size_t i = first; i < last; i++)
+			result = monoid.combine(result, monoid.measure(values[i]));
+		return result;
+	}
+}
+
+// aggregate
+
+TEST(annotated_list_aggregate, shouldSumWholeListAndSubranges)
+{
+	sumlist list;
+	for (long long i = 1; i <= 1000; i++)
+		list.push_back(i);
+
+	EXPECT_EQ(list.aggregate(), 500500);
+	EXPECT_GT(list.chunk_count(), 1);
+	EXPECT_EQ(list.aggregate(list.begin(), list.end()), 500500);
+	EXPECT_EQ(list.aggregate(std::next(list.begin(), 10), std::next(list.begin(), 20)), 155);
+	EXPECT_EQ(list.aggregate(std::next(list.begin(), 100), std::next(list.begin(), 900)), 400400);
+	EXPECT_EQ(list.aggregate(list.begin(), list.begin()), 0);
+}
+
+TEST(annotated_list_aggregate, shouldKeepNonCommutativeOrder)
+{
+	annotated_list<char, concat> list;
+	for (char c : std::string("the quick brown fox jumps over the lazy dog, again and again and again"))
+		list.push_back(c);
+	list.push_front('>');
+
+	EXPECT_EQ(list.aggregate(std::next(list.begin(), 5), std::next(list.begin(), 16)), "quick brown");
+	EXPECT_EQ(list.aggregate().front(), '>');
+	EXPECT_EQ(list.aggregate().size(), list.size());
+}
+
+TEST(annotated_list_aggregate, shouldUpdateAfterModifyingAValue)
+{
+	summarylist list{ 4, 8, 15, 16, 23, 42 };
+	list.update(std::next(list.begin(), 2), [](int& value) { value = -7; });
+
+	const auto result = list.aggregate();
+	EXPECT_EQ(result.count, 6);
+	EXPECT_EQ(result.sum, 86);
+	EXPECT_EQ(result.min, -7);
+	EXPECT_EQ(result.max, 42);
+	EXPECT_THROW(list.update(list.end(), [](int&) {}), std::runtime_error);
+}
+
+// mutation
+
+TEST(annotated_list_mutation, shouldMatchBruteForceUnderRandomEditsAndSplices)
+{
+	std::mt19937 generator(11);
+	summarylist list;
+	std::vector<int> mirror;
+
+	for (int step = 0; step < 4000; step++)
+	{
+		const unsigned roll = generator() % 10;
+		const std::size_t position = mirror.empty() ? 0 : generator() % (mirror.size() + 1);
+		const int value = int(generator() % 2001) - 1000;
+
+		if (roll < 5 || mirror.empty())
+		{
+			list.emplace(std::next(list.begin(), std::ptrdiff_t(position)), value);
+			mirror.insert(mirror.begin() + std::ptrdiff_t(position), value);
+		}
+		else if (roll < 8)
+		{
+			const std::size_t index = position % mirror.size();
+			list.pop(std::next(list.begin(), std::ptrdiff_t(index)));
+			mirror.erase(mirror.begin() + std::ptrdiff_t(index));
+		}
+		else
+		{
+			summarylist other;
+			std::vector<int> inserted;
+			for (unsigned i = generator() % 150; i > 0; i--)
+			{
+				inserted.push_back(int(generator() % 100));
+				other.push_back(inserted.back());
+			}
+			auto where = position == 0 ? list.end() : std::next(list.begin(), std::ptrdiff_t(position - 1));
+			list.splice(where, other);
+			mirror.insert(mirror.begin() + std::ptrdiff_t(position), inserted.begin(), inserted.end());
+			EXPECT_TRUE(other.empty());
+		}
+
+		if (step % 50 == 0)
+		{
+			ASSERT_TRUE(std::equal(list.begin(), list.end(), mirror.begin(), mirror.end()));
+			for (int probe = 0; probe < 10; probe++)
+			{
+				std::size_t first = generator() % (mirror.size() + 1);
+				std::size_t last = generator() % (mirror.size() + 1);
+				if (first > last)
+					std::swap(first, last);
+				ASSERT_EQ(list.aggregate(std::next(list.begin(), std::ptrdiff_t(first)), std::next(list.begin(), std::ptrdiff_t(last))),
+					bruteForce(mirror, first, last));
+			}
+			ASSERT_EQ(list.aggregate(), bruteForce(mirror, 0, mirror.size()));
+		}
+	}
+	EXPECT_EQ(list.size(), mirror.size());
+}
+
+TEST(annotated_list_mutation, shouldDropChunksWhenPopping)
+{
+	sumlist list;
+	for (long long i = 0; i < 500; i++)
+		list.push_back(i);
+	while (list.size() > 1)
+		list.pop_front();
+
+	EXPECT_EQ(list.chunk_count(), 1);
+	EXPECT_EQ(list.aggregate(), 499);
+	list.pop_back();
+	EXPECT_EQ(list.chunk_count(), 0);
+	EXPECT_EQ(list.aggregate(), 0);
+	EXPECT_THROW(list.pop_back(), std::length_error);
+	EXPECT_THROW(list.pop(list.end()), std::length_error);
+}
+
+TEST(annotated_list_mutation, shouldCopyAndMoveWithAnnotations)
+{
+	sumlist list;
+	for (long long i = 0; i < 300; i++)
+		list.push_back(i);
+
+	sumlist copy(list);
+	sumlist moved(std::move(list));
+	EXPECT_TRUE(list.empty());
+	EXPECT_EQ(list.aggregate(), 0);
+	EXPECT_EQ(copy, moved);
+	EXPECT_EQ(moved.aggregate(std::next(moved.begin(), 100), moved.end()), 39900);
+
+	copy.push_front(1000);
+	EXPECT_EQ(copy.aggregate(), 44850 + 1000);
+	EXPECT_EQ(*copy.rbegin(), 299);
+}
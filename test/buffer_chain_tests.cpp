@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include "../list/buffer_chain.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+	std::span<std::byte> bytesOf(std::string& text)
+	{
+		return std::as_writable_bytes(std::span<char>(text));
+	}
+
+	std::span<const std::byte> bytesOf(std::string_view text)
+	{
+		return std::as_bytes(std::span<const char>(text.data(), text.size()));
+	}
+
+	std::string flatten(const buffer_chain& chain)
+	{
+		std::string result;
+		for (const auto& current : chain.chain())
+			result.append(reinterpret_cast<const char*>(current.bytes.data()), current.bytes.size());
+		return result;
+	}
+
+	std::string readAll(int fd, std::size_t expected)
+	{
+		std::string result(expected, '\0');
+		std::size_t got = 0;
+		while (got < expected)
+		{
+			const ssize_t n = ::read(fd, result.data() + got, expected - got);
+			if (n <= 0)
+				break;
+			got += static_cast<std::size_t>(n);
+		}
+		result.resize(got);
+		return result;
+	}
+}
+
+// building and consuming
+
+TEST(buffer_chain_build, shouldAppendBorrowedBuffersWithoutCopying)
+{
+	std::string first = "hello ";
+	std::string second = "world";
+	buffer_chain chain;
+	chain.append(bytesOf(first));
+	chain.append(bytesOf(second));
+
+	EXPECT_EQ(chain.size(), 11);
+	EXPECT_EQ(chain.buffer_count(), 2);
+	EXPECT_EQ(chain.chain().front().bytes.data(), reinterpret_cast<std::byte*>(first.data()));
+	EXPECT_EQ(flatten(chain), "hello world");
+}
+
+TEST(buffer_chain_build, shouldPackCopiesIntoPooledBlocks)
+{
+	buffer_pool pool(64);
+	buffer_chain chain(pool);
+	for (int i = 0; i < 10; i++)
+		chain.append_copy(bytesOf("0123456789abcdef"));
+
+	EXPECT_EQ(chain.size(), 160);
+	EXPECT_EQ(chain.buffer_count(), 3);
+	EXPECT_EQ(pool.allocated_blocks(), 3);
+	EXPECT_EQ(flatten(chain).substr(150), "6789abcdef");
+	EXPECT_EQ(flatten(chain).substr(0, 20), "0123456789abcdef0123");
+}
+
+TEST(buffer_chain_build, shouldConsumeAndTrimFrontBuffers)
+{
+	buffer_pool pool(8);
+	buffer_chain chain(pool);
+	std::string borrowed = "abc";
+	chain.append(bytesOf(borrowed));
+	chain.append_copy(bytesOf("defghijklmno"));
+
+	chain.consume(2);
+	EXPECT_EQ(flatten(chain), "cdefghijklmno");
+	chain.consume(5);
+	EXPECT_EQ(flatten(chain), "hijklmno");
+	EXPECT_EQ(chain.buffer_count(), 2);
+	EXPECT_EQ(pool.cached_blocks(), 0);
+
+	EXPECT_THROW(chain.consume(100), std::length_error);
+	chain.consume(8);
+	EXPECT_TRUE(chain.empty());
+	EXPECT_EQ(chain.buffer_count(), 0);
+	EXPECT_EQ(pool.cached_blocks(), 2);
+
+	chain.append_copy(bytesOf("again"));
+	EXPECT_EQ(pool.allocated_blocks(), 2);
+	EXPECT_EQ(pool.reused_blocks(), 1);
+}
+
+TEST(buffer_chain_build, shouldMoveEmptyAndFilledChains)
+{
+	buffer_chain empty;
+	buffer_chain movedEmpty(std::move(empty));
+	EXPECT_TRUE(movedEmpty.empty());
+	EXPECT_EQ(movedEmpty.buffer_count(), 0);
+
+	buffer_chain filled;
+	filled.append_copy(bytesOf("payload"));
+	buffer_chain movedFilled(std::move(filled));
+	EXPECT_TRUE(filled.empty());
+	EXPECT_EQ(flatten(movedFilled), "payload");
+}
+
+TEST(buffer_chain_build, shouldFillIovecsUpToMax)
+{
+	std::string parts[4] = { "a", "bb", "ccc", "dddd" };
+	buffer_chain chain;
+	for (auto& part : parts)
+		chain.append(bytesOf(part));
+
+	iovec vectors[3];
+	EXPECT_EQ(chain.as_iovecs(vectors, 3), 3);
+	EXPECT_EQ(vectors[0].iov_base, parts[0].data());
+	EXPECT_EQ(vectors[2].iov_len, 3);
+	EXPECT_EQ(chain.as_iovecs(std::span<iovec>(vectors, 0)), 0);
+}
+
+// file descriptors
+
+TEST(buffer_chain_io, shouldWriteChainThroughPipe)
+{
+	int fds[2];
+	ASSERT_EQ(::pipe(fds), 0);
+
+	std::string header = "HTTP/1.1 200 OK\r\n\r\n";
+	std::string body(3000, 'x');
+	buffer_chain chain;
+	chain.append(bytesOf(header));
+	chain.append(bytesOf(body));
+	chain.append_copy(bytesOf("trailer"));
+
+	const std::size_t total = chain.size();
+	std::size_t written = 0;
+	while (!chain.empty())
+		written += chain.write_to(fds[1]);
+	EXPECT_EQ(written, total);
+
+	EXPECT_EQ(readAll(fds[0], total), header + body + "trailer");
+	::close(fds[0]);
+	::close(fds[1]);
+}
+
+TEST(buffer_chain_io, shouldResumeAfterPartialWritesOnSocketPair)
+{
+	int fds[2];
+	ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+	ASSERT_EQ(::fcntl(fds[0], F_SETFL, O_NONBLOCK), 0);
+
+	std::string payload;
+	for (int i = 0; i < 200000; i++)
+		payload.push_back(char('a' + i % 26));
+
+	buffer_pool pool(4096);
+	buffer_chain outgoing(pool);
+	outgoing.append_copy(bytesOf(payload));
+
+	buffer_chain incoming(pool);
+	while (!outgoing.empty() || incoming.size() < payload.size())
+	{
+		outgoing.write_to(fds[0], 8);
+		incoming.read_from(fds[1], std::min<std::size_t>(65536, payload.size() - incoming.size()));
+	}
+
+	EXPECT_EQ(flatten(incoming), payload);
+	::close(fds[0]);
+	::close(fds[1]);
+}
+
+TEST(buffer_chain_io, shouldReadIntoSpareTailSpace)
+{
+	int fds[2];
+	ASSERT_EQ(::pipe(fds), 0);
+	ASSERT_EQ(::write(fds[1], "0123456789", 10), 10);
+
+	buffer_pool pool(16);
+	buffer_chain chain(pool);
+	chain.append_copy(bytesOf("ab"));
+	EXPECT_EQ(chain.read_from(fds[0], 10), 10);
+	EXPECT_EQ(flatten(chain), "ab0123456789");
+	EXPECT_EQ(chain.buffer_count(), 1);
+
+	::close(fds[1]);
+	EXPECT_EQ(chain.read_from(fds[0], 10), 0);
+	EXPECT_EQ(pool.cached_blocks(), 1);
+	::close(fds[0]);
+}
@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+#include "../list/external_sort.h"
+#include <algorithm>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct record
+	{
+		int key;
+		int order;
+	};
+
+	struct brittle
+	{
+		static inline int writesLeft = -1;
+		static inline int readsLeft = -1;
+		int value;
+
+		static void countDown(int& left)
+		{
+			if (left >= 0 && left-- == 0)
+				throw std::runtime_error("simulated I/O failure");
+		}
+
+		bool operator<(const brittle& other) const { return value < other.value; }
+	};
+}
+
+template<>
+struct list_io::serializer<brittle>
+{
+	static void write(writer& out, const brittle& value)
+	{
+		brittle::countDown(brittle::writesLeft);
+		out.write_raw(value.value);
+	}
+
+	static brittle read(reader& in)
+	{
+		brittle::countDown(brittle::readsLeft);
+		return { in.read_raw<int>() };
+	}
+};
+
+namespace
+{
+	std::filesystem::path freshDirectory(const std::string& name)
+	{
+		const std::filesystem::path directory = std::filesystem::path(testing::TempDir()) / ("external_sort_" + name);
+		std::filesystem::remove_all(directory);
+		std::filesystem::create_directories(directory);
+		return directory;
+	}
+
+	bool isEmptyDirectory(const std::filesystem::path& directory)
+	{
+		return std::filesystem::directory_iterator(directory) == std::filesystem::directory_iterator();
+	}
+
+	template<typename T>
+	std::vector<T> contents(const list<T>& target)
+	{
+		std::vector<T> result;
+		target.for_each([&](const T& value) { result.push_back(value); });
+		return result;
+	}
+
+	std::vector<int> failedSortContents(const std::filesystem::path& directory, int& failAfter, int at, std::size_t fanIn)
+	{
+		list<brittle> target;
+		for (int i = 0; i < 1000; i++)
+			target.push_back({ (i * 7919) % 1000 });
+
+		external_sort_options options;
+		options.fan_in = fanIn;
+		failAfter = at;
+		EXPECT_THROW(external_sort(target, 100 * list<brittle>::node_bytes, directory, options), std::runtime_error);
+		failAfter = -1;
+		EXPECT_TRUE(isEmptyDirectory(directory));
+
+		std::vector<int> values;
+		target.for_each([&](const brittle& element) { values.push_back(element.value); });
+		std::sort(values.begin(), values.end());
+		return values;
+	}
+}
+
+// external sort
+
+TEST(external_sort, shouldSortInMemoryWhenBudgetAllows)
+{
+	const auto directory = freshDirectory("inmemory");
+	list<int> target{ 5, 3, 9, 1, 7 };
+	external_sort(target, 1 << 20, directory);
+	EXPECT_EQ(contents(target), (std::vector<int>{ 1, 3, 5, 7, 9 }));
+	EXPECT_TRUE(isEmptyDirectory(directory));
+}
+
+TEST(external_sort, shouldSortWithBudgetFarBelowDataSize)
+{
+	const auto directory = freshDirectory("spill");
+	std::mt19937 generator(42);
+	std::uniform_int_distribution<int> distribution(-1000000, 1000000);
+
+	std::vector<int> expected;
+	list<int> target;
+	for (int i = 0; i < 50000; i++)
+	{
+		const int value = distribution(generator);
+		expected.push_back(value);
+		target.push_back(value);
+	}
+	std::sort(expected.begin(), expected.end());
+
+	external_sort_options options;
+	options.fan_in = 4;
+	options.io_buffer_bytes = 4096;
+	external_sort(target, 500 * list<int>::node_bytes, directory, options);
+
+	EXPECT_EQ(target.size(), expected.size());
+	EXPECT_EQ(contents(target), expected);
+	EXPECT_TRUE(isEmptyDirectory(directory));
+}
+
+TEST(external_sort, shouldBeStableAndHonourComparator)
+{
+	const auto directory = freshDirectory("stable");
+	list<record> target;
+	for (int i = 0; i < 3000; i++)
+		target.push_back({ (i * 7) % 10, i });
+
+	external_sort_options options;
+	options.fan_in = 3;
+	external_sort(target, 100 * list<record>::node_bytes, directory, options,
+		[](const record& a, const record& b) { return a.key > b.key; });
+
+	const auto sorted = contents(target);
+	ASSERT_EQ(sorted.size(), 3000);
+	for (std::size_t i = 1; i < sorted.size(); i++)
+	{
+		ASSERT_GE(sorted[i - 1].key, sorted[i].key);
+		if (sorted[i - 1].key == sorted[i].key)
+		{
+			ASSERT_LT(sorted[i - 1].order, sorted[i].order);
+		}
+	}
+}
+
+TEST(external_sort, shouldSortCustomSerializedValues)
+{
+	const auto directory = freshDirectory("strings");
+	list<std::string> target;
+	std::vector<std::string> expected;
+	for (int i = 0; i < 2000; i++)
+	{
+		std::string value = std::to_string((i * 7919) % 2000);
+		expected.push_back(value);
+		target.push_back(value);
+	}
+	std::sort(expected.begin(), expected.end());
+
+	external_sort(target, 64 * list<std::string>::node_bytes, directory);
+	EXPECT_EQ(contents(target), expected);
+}
+
+TEST(external_sort, shouldCountHeapPayloadAgainstTheBudget)
+{
+	const auto directory = freshDirectory("footprint");
+	list<brittle> target;
+	for (int i = 0; i < 100; i++)
+		target.push_back({ 99 - i });
+
+	brittle::writesLeft = 0;
+	external_sort(target, 1 << 20, directory);
+	EXPECT_EQ(target.front().value, 0);
+
+	EXPECT_THROW(external_sort(target, 1 << 20, directory, {}, std::less<>{}, [](const brittle&) { return std::size_t(1) << 16; }), std::runtime_error);
+	brittle::writesLeft = -1;
+	EXPECT_EQ(target.size(), 100);
+	EXPECT_TRUE(isEmptyDirectory(directory));
+}
+
+TEST(external_sort, shouldRestoreDataWhenARunFailsToWrite)
+{
+	const auto directory = freshDirectory("writefail");
+	std::vector<int> expected(1000);
+	for (int i = 0; i < 1000; i++)
+		expected[std::size_t(i)] = i;
+
+	EXPECT_EQ(failedSortContents(directory, brittle::writesLeft, 350, 16), expected);
+}
+
+TEST(external_sort, shouldRestoreDataWhenAMergeFailsToRead)
+{
+	const auto directory = freshDirectory("readfail");
+	std::vector<int> expected(1000);
+	for (int i = 0; i < 1000; i++)
+		expected[std::size_t(i)] = i;
+
+	EXPECT_EQ(failedSortContents(directory, brittle::readsLeft, 500, 16), expected);
+	EXPECT_EQ(failedSortContents(directory, brittle::readsLeft, 150, 3), expected);
+	EXPECT_EQ(failedSortContents(directory, brittle::readsLeft, 1500, 3), expected);
+}
+
+TEST(external_sort, shouldRejectInvalidConfiguration)
+{
+	const auto directory = freshDirectory("invalid");
+	list<int> target{ 2, 1 };
+
+	external_sort_options options;
+	options.fan_in = 1;
+	EXPECT_THROW(external_sort(target, 1 << 20, directory, options), std::invalid_argument);
+	EXPECT_THROW(external_sort(target, 1, directory), std::invalid_argument);
+	EXPECT_EQ(contents(target), (std::vector<int>{ 2, 1 }));
+}
@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include "../list/forward_list.h"
+#include <string>
+#include <utility>
+
+using intforwardlist = forward_list<int>;
+
+namespace
+{
+	testing::AssertionResult compareList(const intforwardlist& list, const intforwardlist& list2)
+	{
+		if (list == list2)
+			return testing::AssertionSuccess();
+		else
+		{
+			auto fillStringWithList = [](std::string& str, const intforwardlist& target)
+				{
+					for (int e : target)
+						str.append(std::to_string(e) + " ");
+				};
+
+			std::string list1String;
+			std::string list2String;
+
+			fillStringWithList(list1String, list);
+			fillStringWithList(list2String, list2);
+
+			return testing::AssertionFailure() << "List 1: " << list1String
+				<< " List2: " << list2String;
+		}
+	}
+
+	auto isEven = [](int e) {return e % 2 == 0; };
+}
+
+// push and pop
+
+TEST(forward_list_push, shouldPushOnBothEnds)
+{
+	intforwardlist list;
+	list.push_back(2);
+	list.push_front(1);
+	list.emplace_back(3);
+	EXPECT_TRUE(compareList(list, intforwardlist{ 1,2,3 }));
+	EXPECT_EQ(list.back(), 3);
+}
+
+TEST(forward_list_pop, shouldBehaveAsAQueue)
+{
+	intforwardlist list;
+	for (int i = 0; i < 5; i++)
+		list.push_back(i);
+	list.pop_front();
+	list.pop_front();
+	EXPECT_EQ(list.front(), 2);
+	EXPECT_EQ(list.size(), 3);
+	while (!list.empty())
+		list.pop_front();
+	list.push_back(9);
+	EXPECT_EQ(list.front(), 9);
+	EXPECT_EQ(list.back(), 9);
+}
+
+TEST(forward_list_pop, shouldThrowLengthErrorIfEmpty)
+{
+	intforwardlist list;
+	EXPECT_THROW(list.pop_front(), std::length_error);
+	EXPECT_THROW(list.front(), std::length_error);
+	EXPECT_THROW(list.back(), std::length_error);
+}
+
+TEST(forward_list_copy, shouldCopyAndMove)
+{
+	intforwardlist list{ 1,2,3 };
+	intforwardlist copy = list;
+	intforwardlist moved = std::move(list);
+	EXPECT_TRUE(compareList(copy, moved));
+	EXPECT_TRUE(list.empty());
+	moved.push_back(4);
+	EXPECT_EQ(moved.back(), 4);
+}
+
+// iterators
+
+TEST(forward_list_iterator, shouldThrowExceptionIfTriesToGetEndValue)
+{
+	intforwardlist list{ 1 };
+	EXPECT_THROW(*list.end(), std::runtime_error);
+}
+
+// insert and erase after
+
+TEST(forward_list_insert_after, shouldInsertAfterTheIteratorGiven)
+{
+	intforwardlist list{ 1,3 };
+	auto it = list.insert_after(list.begin(), 2);
+	EXPECT_EQ(*it, 2);
+	list.insert_after(list.before_begin(), 0);
+	EXPECT_TRUE(compareList(list, intforwardlist{ 0,1,2,3 }));
+}
+
+TEST(forward_list_insert_after, shouldUpdateTail)
+{
+	intforwardlist list{ 1 };
+	list.insert_after(list.begin(), 2);
+	list.push_back(3);
+	EXPECT_TRUE(compareList(list, intforwardlist{ 1,2,3 }));
+}
+
+TEST(forward_list_erase_after, shouldEraseTheFollowingElement)
+{
+	intforwardlist list{ 1,2,3 };
+	auto it = list.erase_after(list.begin());
+	EXPECT_EQ(*it, 3);
+	list.erase_after(list.begin());
+	EXPECT_EQ(list.back(), 1);
+	list.push_back(4);
+	EXPECT_TRUE(compareList(list, intforwardlist{ 1,4 }));
+}
+
+TEST(forward_list_erase_after, shouldThrowIfNothingFollows)
+{
+	intforwardlist list{ 1 };
+	EXPECT_THROW(list.erase_after(list.begin()), std::runtime_error);
+}
+
+TEST(forward_list_erase_after, shouldEraseTheRange)
+{
+	intforwardlist list{ 1,2,3,4,5 };
+	list.erase_after(list.begin(), list.end());
+	EXPECT_TRUE(compareList(list, intforwardlist{ 1 }));
+	EXPECT_EQ(list.back(), 1);
+}
+
+// splice after
+
+TEST(forward_list_splice_after, shouldSpliceAfterWhere)
+{
+	intforwardlist list{ 1,2,3 };
+	intforwardlist splicedlist{ 9,8,7 };
+	list.splice_after(list.begin(), splicedlist);
+	EXPECT_TRUE(compareList(list, intforwardlist{ 1,9,8,7,2,3 }));
+	EXPECT_EQ(list.size(), 6);
+	EXPECT_TRUE(splicedlist.empty());
+}
+
+TEST(forward_list_splice_after, shouldUpdateTailWhenSplicingAtTheEnd)
+{
+	intforwardlist list{ 1 };
+	intforwardlist splicedlist{ 2,3 };
+	list.splice_after(list.begin(), splicedlist);
+	list.push_back(4);
+	EXPECT_TRUE(compareList(list, intforwardlist{ 1,2,3,4 }));
+}
+
+// algorithms
+
+TEST(forward_list_remove_if, shouldRemoveMatches)
+{
+	intforwardlist list{ 2,1,4,3,6 };
+	EXPECT_EQ(list.remove_if(isEven), 3);
+	EXPECT_TRUE(compareList(list, intforwardlist{ 1,3 }));
+	list.push_back(5);
+	EXPECT_EQ(list.back(), 5);
+}
+
+TEST(forward_list_sort, shouldSortList)
+{
+	intforwardlist list{ 0,6,2,3,9,7,1,4,5,8 };
+	list.sort();
+	EXPECT_TRUE(compareList(list, intforwardlist{ 0,1,2,3,4,5,6,7,8,9 }));
+	EXPECT_EQ(list.back(), 9);
+}
+
+TEST(forward_list_sort, shouldBeStable)
+{
+	forward_list<std::pair<int, int>> list{ {2,0},{1,0},{2,1},{1,1},{2,2} };
+	list.sort([](const auto& a, const auto& b) { return a.first < b.first; });
+	forward_list<std::pair<int, int>> expected{ {1,0},{1,1},{2,0},{2,1},{2,2} };
+	EXPECT_TRUE(list == expected);
+}
+
+TEST(forward_list_sort, shouldSortLongLists)
+{
+	intforwardlist list;
+	for (int i = 0; i < 1000; i++)
+		list.push_back((i * 7919) % 1000);
+	list.sort(std::greater<>());
+	EXPECT_EQ(list.front(), 999);
+	EXPECT_EQ(list.back(), 0);
+	EXPECT_EQ(list.size(), 1000);
+}
+
+TEST(forward_list_traversal, findCountAccumulate)
+{
+	intforwardlist list{ 1,2,3,4 };
+	EXPECT_EQ(*list.find(3), 3);
+	EXPECT_TRUE(list.find(7) == list.end());
+	EXPECT_TRUE(list.contains(4));
+	EXPECT_EQ(list.count_if(isEven), 2);
+	EXPECT_EQ(list.accumulate(0), 10);
+}
@@ -0,0 +1,300 @@
+#include <gtest/gtest.h>
+#include "../list/index_list.h"
+#include <string>
+
+using intindexlist = index_list<int>;
+
+namespace
+{
+	testing::AssertionResult compareList(const intindexlist& list, const intindexlist& list2)
+	{
+		if (list == list2)
+			return testing::AssertionSuccess();
+		else
+		{
+			auto fillStringWithList = [](std::string& str, const intindexlist& target)
+				{
+					for (int e : target)
+						str.append(std::to_string(e) + " ");
+				};
+
+			std::string list1String;
+			std::string list2String;
+
+			fillStringWithList(list1String, list);
+			fillStringWithList(list2String, list2);
+
+			return testing::AssertionFailure() << "List 1: " << list1String
+				<< " List2: " << list2String;
+		}
+	}
+
+	auto isEven = [](int e) {return e % 2 == 0; };
+
+	struct fragile
+	{
+		static inline int copiesLeft = -1;
+		static inline int alive = 0;
+		int value;
+
+		fragile(int value) : value(value) { ++alive; }
+		fragile(const fragile& other) : value(other.value)
+		{
+			if (copiesLeft == 0)
+				throw std::runtime_error("copy failed");
+			--copiesLeft;
+			++alive;
+		}
+		fragile(fragile&& other) noexcept(false) : value(other.value) { ++alive; }
+		~fragile() { --alive; }
+	};
+}
+
+// construction
+
+TEST(index_list_construction, defaultShouldBeEmpty)
+{
+	intindexlist list;
+	EXPECT_TRUE(list.empty());
+	EXPECT_TRUE(list.begin() == list.end());
+}
+
+TEST(index_list_construction, initializerListShouldKeepOrder)
+{
+	intindexlist list{ 1,2,3 };
+	EXPECT_EQ(list.size(), 3);
+	EXPECT_EQ(list.front(), 1);
+	EXPECT_EQ(list.back(), 3);
+}
+
+TEST(index_list_construction, copyShouldBeIndependent)
+{
+	intindexlist list{ 1,2,3 };
+	intindexlist copy = list;
+	list.pop_front();
+	EXPECT_TRUE(compareList(copy, intindexlist{ 1,2,3 }));
+}
+
+TEST(index_list_construction, copyOfNonTrivialType)
+{
+	index_list<std::string> list{ "a", "b" };
+	index_list<std::string> copy = list;
+	EXPECT_EQ(copy.front(), "a");
+	EXPECT_EQ(copy.back(), "b");
+}
+
+TEST(index_list_construction, moveShouldLeaveSourceEmpty)
+{
+	intindexlist list{ 1,2,3 };
+	intindexlist moved = std::move(list);
+	EXPECT_EQ(moved.size(), 3);
+	EXPECT_TRUE(list.empty());
+	list.push_back(4);
+	EXPECT_EQ(list.front(), 4);
+}
+
+// push and pop
+
+TEST(index_list_push, shouldPushOnBothEnds)
+{
+	intindexlist list;
+	list.push_back(2);
+	list.push_front(1);
+	list.emplace_back(3);
+	EXPECT_TRUE(compareList(list, intindexlist{ 1,2,3 }));
+}
+
+TEST(index_list_push, shouldSurviveManyRelocations)
+{
+	index_list<std::string> list;
+	for (int i = 0; i < 1000; i++)
+		list.push_back(std::to_string(i));
+	EXPECT_EQ(list.size(), 1000);
+	EXPECT_EQ(list.back(), "999");
+	EXPECT_GE(list.capacity(), 1000);
+}
+
+TEST(index_list_push, shouldPushOwnElementAcrossRelocation)
+{
+	index_list<std::string> list{ std::string(64, 'a') };
+	for (int i = 0; i < 100; i++)
+	{
+		list.push_back(list.front());
+		list.push_front(list.back());
+	}
+	EXPECT_EQ(list.size(), 201);
+	for (const std::string& element : list)
+		EXPECT_EQ(element, std::string(64, 'a'));
+}
+
+TEST(index_list_push, shouldKeepContentsWhenRelocationThrows)
+{
+	{
+		index_list<fragile> list;
+		while (list.size() < list.capacity() || list.empty())
+			list.emplace_back(int(list.size()));
+		const std::size_t size = list.size();
+		const std::size_t capacity = list.capacity();
+
+		fragile::copiesLeft = 3;
+		EXPECT_THROW(list.emplace_back(-1), std::runtime_error);
+		fragile::copiesLeft = -1;
+
+		EXPECT_EQ(list.size(), size);
+		EXPECT_EQ(list.capacity(), capacity);
+		EXPECT_EQ(fragile::alive, int(size));
+		int expected = 0;
+		for (const fragile& element : list)
+			EXPECT_EQ(element.value, expected++);
+
+		list.emplace_back(-1);
+		EXPECT_EQ(list.back().value, -1);
+	}
+	EXPECT_EQ(fragile::alive, 0);
+}
+
+TEST(index_list_pop, shouldPopBothEnds)
+{
+	intindexlist list{ 1,2,3 };
+	list.pop_back();
+	list.pop_front();
+	EXPECT_TRUE(compareList(list, intindexlist{ 2 }));
+}
+
+TEST(index_list_pop, shouldThrowLengthErrorIfEmpty)
+{
+	intindexlist list;
+	EXPECT_THROW(list.pop_back(), std::length_error);
+	EXPECT_THROW(list.pop_front(), std::length_error);
+	EXPECT_THROW(list.front(), std::length_error);
+}
+
+TEST(index_list_pop, shouldRecycleFreedSlots)
+{
+	intindexlist list;
+	list.reserve(4);
+	for (int i = 0; i < 100; i++)
+	{
+		list.push_back(i);
+		list.pop_front();
+	}
+	EXPECT_EQ(list.capacity(), 4);
+}
+
+// iterators
+
+TEST(index_list_iterator, shouldTraverseBothDirections)
+{
+	intindexlist list{ 1,2,3 };
+	auto it = list.begin();
+	EXPECT_EQ(*it, 1);
+	EXPECT_EQ(*++it, 2);
+	EXPECT_EQ(*--it, 1);
+	EXPECT_EQ(*list.rbegin(), 3);
+	EXPECT_EQ(*++list.crbegin(), 2);
+}
+
+TEST(index_list_iterator, shouldThrowExceptionIfTriesToGetHeadValue)
+{
+	intindexlist list{ 1 };
+	EXPECT_THROW(*list.end(), std::runtime_error);
+}
+
+TEST(index_list_iterator, shouldStayValidAcrossGrowth)
+{
+	intindexlist list{ 1 };
+	auto it = list.begin();
+	for (int i = 0; i < 100; i++)
+		list.push_back(i);
+	EXPECT_EQ(*it, 1);
+}
+
+TEST(index_list_iterator, constIteratorFromIterator)
+{
+	intindexlist list{ 1,2 };
+	intindexlist::const_iterator cit = list.begin();
+	EXPECT_TRUE(cit == list.begin());
+}
+
+// positional operations
+
+TEST(index_list_insert, shouldInsertBeforeTheIteratorGiven)
+{
+	intindexlist list{ 1,3 };
+	auto it = list.insert(++list.begin(), 2);
+	EXPECT_EQ(*it, 2);
+	EXPECT_TRUE(compareList(list, intindexlist{ 1,2,3 }));
+}
+
+TEST(index_list_insert, shouldInsertInEmptyList)
+{
+	intindexlist list;
+	list.emplace(list.end(), 5);
+	EXPECT_TRUE(compareList(list, intindexlist{ 5 }));
+}
+
+TEST(index_list_pop, shouldPopAtIteratorAndReturnNext)
+{
+	intindexlist list{ 1,2,3 };
+	auto it = list.pop(list.begin());
+	EXPECT_EQ(*it, 2);
+	EXPECT_THROW(list.pop(list.end()), std::runtime_error);
+}
+
+TEST(index_list_erase, shouldEraseTheRange)
+{
+	intindexlist list{ 1,2,3,4,5 };
+	list.erase(++list.begin(), --list.end());
+	EXPECT_TRUE(compareList(list, intindexlist{ 1,5 }));
+}
+
+// algorithms
+
+TEST(index_list_remove_if, shouldRemoveMatches)
+{
+	intindexlist list{ 1,2,3,4,5,6 };
+	EXPECT_EQ(list.remove_if(isEven), 3);
+	EXPECT_TRUE(compareList(list, intindexlist{ 1,3,5 }));
+}
+
+TEST(index_list_extract_if, shouldReturnTheRemovedElements)
+{
+	intindexlist list{ 1,2,3,4 };
+	intindexlist removed = list.extract_if(isEven);
+	EXPECT_TRUE(compareList(list, intindexlist{ 1,3 }));
+	EXPECT_TRUE(compareList(removed, intindexlist{ 2,4 }));
+}
+
+TEST(index_list_splice, shouldSpliceAfterWhere)
+{
+	intindexlist list{ 1,2,3 };
+	intindexlist splicedlist{ 9,8,7 };
+	list.splice(list.begin(), splicedlist);
+	EXPECT_TRUE(compareList(list, intindexlist{ 1,9,8,7,2,3 }));
+	EXPECT_TRUE(splicedlist.empty());
+}
+
+TEST(index_list_sort, shouldSortList)
+{
+	intindexlist list{ 0,6,2,3,9,7,1,4,5,8 };
+	list.sort();
+	EXPECT_TRUE(compareList(list, intindexlist{ 0,1,2,3,4,5,6,7,8,9 }));
+	EXPECT_EQ(*list.rbegin(), 9);
+}
+
+TEST(index_list_traversal, findCountAccumulate)
+{
+	intindexlist list{ 1,2,3,4 };
+	EXPECT_EQ(*list.find(3), 3);
+	EXPECT_TRUE(list.find(7) == list.end());
+	EXPECT_TRUE(list.contains(4));
+	EXPECT_EQ(list.count_if(isEven), 2);
+	EXPECT_EQ(list.accumulate(0), 10);
+}
+
+TEST(index_list_comparison, shouldCompareLexicographically)
+{
+	EXPECT_TRUE(intindexlist({ 1,2 }) == intindexlist({ 1,2 }));
+	EXPECT_TRUE(intindexlist({ 1,2 }) < intindexlist({ 1,3 }));
+	EXPECT_TRUE(intindexlist({ 1 }) < intindexlist({ 1,0 }));
+}
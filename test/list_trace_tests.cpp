@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "../list/list_trace.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+using list_stats::trace_event;
+using list_stats::trace_op;
+
+namespace
+{
+	std::vector<trace_event> readTrace(const std::string& bytes)
+	{
+		std::istringstream stream(bytes);
+		list_trace::reader in(stream);
+		std::vector<trace_event> events;
+		trace_event event{};
+		while (in.next(event))
+			events.push_back(event);
+		return events;
+	}
+}
+
+// recording
+
+TEST(list_trace_recording, shouldRecordMutationsWithIndexAndValueSize)
+{
+	std::ostringstream stream;
+	list_trace::writer out(stream);
+	list_trace::recorded_list<int> list;
+	list.recorder().attach(out);
+
+	list.push_back(1);
+	list.push_back(2);
+	list.push_front(0);
+	list.insert(std::next(list.begin(), 2), 5);
+	list.pop(std::next(list.begin()));
+	list.pop_back();
+	list.pop_front();
+	out.close();
+
+	const std::vector<trace_event> expected = {
+		{ trace_op::push_back, 0, 1, sizeof(int) },
+		{ trace_op::push_back, 1, 1, sizeof(int) },
+		{ trace_op::push_front, 0, 1, sizeof(int) },
+		{ trace_op::insert, 2, 1, sizeof(int) },
+		{ trace_op::erase, 1, 1, 0 },
+		{ trace_op::pop_back, 2, 1, 0 },
+		{ trace_op::pop_front, 0, 1, 0 },
+	};
+	EXPECT_EQ(readTrace(stream.str()), expected);
+	EXPECT_EQ(out.written(), expected.size());
+}
+
+TEST(list_trace_recording, shouldRecordBulkOperations)
+{
+	std::ostringstream stream;
+	list_trace::writer out(stream);
+	list_trace::recorded_list<int> list;
+	list.recorder().attach(out);
+
+	list.append_n(6, [i = 0]() mutable { return i++; });
+	list_trace::recorded_list<int> other{ 7, 8 };
+	list.splice(list.begin(), other);
+	list.erase(list.begin(), std::next(list.begin(), 2));
+	list.remove_if([](int e) { return e % 2 == 0; });
+	list.merge_sort();
+	(void)list.contains(-1);
+	list.clear();
+	out.close();
+
+	const std::vector<trace_event> expected = {
+		{ trace_op::push_back, 0, 6, sizeof(int) },
+		{ trace_op::splice, 1, 2, 0 },
+		{ trace_op::erase_range, 0, 2, 0 },
+		{ trace_op::remove_if, 6, 3, 0 },
+		{ trace_op::sort, 0, 3, 0 },
+		{ trace_op::traverse, 0, 3, 0 },
+		{ trace_op::clear, 0, 3, 0 },
+	};
+	EXPECT_EQ(readTrace(stream.str()), expected);
+}
+
+TEST(list_trace_recording, shouldRecordHeapPayloadOfValues)
+{
+	std::ostringstream stream;
+	list_trace::writer out(stream);
+	list_trace::recorded_list<std::string> list;
+	list.recorder().attach(out);
+	list.push_back(std::string(100, 'x'));
+	list.recorder().detach();
+	list.push_back("ignored");
+	out.close();
+
+	const auto events = readTrace(stream.str());
+	ASSERT_EQ(events.size(), 1);
+	EXPECT_EQ(events[0].value_bytes, sizeof(std::string) + 100);
+}
+
+TEST(list_trace_recording, shouldRecordAlongsideCounters)
+{
+	std::ostringstream stream;
+	list_trace::writer out(stream);
+	list<int, list_stats::combine<list_trace::recording, list_stats::counters>> list;
+	list.recorder().attach(out);
+	list.push_back(1);
+	list.push_front(0);
+	out.close();
+
+	EXPECT_EQ(readTrace(stream.str()).size(), 2);
+	EXPECT_EQ(list.stats().allocations, 2);
+}
+
+TEST(list_trace_recording, shouldNotRecordCopiesOrDestruction)
+{
+	std::ostringstream stream;
+	list_trace::writer out(stream);
+	{
+		list_trace::recorded_list<int> list;
+		list.recorder().attach(out);
+		list.push_back(1);
+		list_trace::recorded_list<int> copy(list);
+		copy.push_back(2);
+		EXPECT_FALSE(copy.recorder().attached());
+	}
+	out.close();
+	EXPECT_EQ(readTrace(stream.str()).size(), 1);
+}
+
+TEST(list_trace_recording, shouldRejectForeignData)
+{
+	std::istringstream stream("definitely not a trace");
+	EXPECT_THROW(list_trace::reader in(stream), std::runtime_error);
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "../list/list.h"
+#if defined(LIST_TEST_STD_EXECUTION)
+#include "../list/parallel_execution.h"
+#endif
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+	list<int> makeSequence(int elements)
+	{
+		list<int> result;
+		for (int i = 0; i < elements; i++)
+			result.push_back(i);
+		return result;
+	}
+}
+
+// parallel algorithms
+
+TEST(parallel_algorithms, shouldVisitEveryElementOnce)
+{
+	list_parallel::thread_pool pool(4);
+	list<int> values = makeSequence(100000);
+	std::atomic<long long> total{ 0 };
+	values.for_each(pool, [&](int e) { total += e; });
+	EXPECT_EQ(total.load(), 4999950000LL);
+	static_assert(std::is_void_v<decltype(values.for_each(pool, [](int) {}))>);
+
+	values.transform(pool, [](int e) { return e * 2; });
+	EXPECT_EQ(values.accumulate(0LL), 2 * 4999950000LL);
+	EXPECT_EQ(values.front(), 0);
+	EXPECT_EQ(values.back(), 199998);
+}
+
+TEST(parallel_algorithms, shouldCountAndReduceLikeSequentialVersions)
+{
+	list_parallel::thread_pool pool(3);
+	const list<int> values = makeSequence(50001);
+	auto isOdd = [](int e) { return e % 2 != 0; };
+
+	EXPECT_EQ(values.count_if(pool, isOdd), values.count_if(isOdd));
+	EXPECT_EQ(values.count_if(list_parallel::par, isOdd), 25000);
+	EXPECT_EQ(values.reduce(pool, 0LL), values.accumulate(0LL));
+	EXPECT_EQ(values.reduce(list_parallel::seq, 7LL), values.accumulate(7LL));
+	EXPECT_EQ(list<int>{}.reduce(pool, 5), 5);
+}
+
+TEST(parallel_algorithms, shouldCombineReductionsDeterministically)
+{
+	list<double> values;
+	for (int i = 0; i < 100000; i++)
+		values.push_back(1.0 / (1.0 + i));
+
+	list_parallel::thread_pool small(1);
+	list_parallel::thread_pool large(7);
+	const double sequential = values.reduce(list_parallel::seq, 0.0);
+	EXPECT_EQ(values.reduce(small, 0.0), sequential);
+	EXPECT_EQ(values.reduce(large, 0.0), sequential);
+	EXPECT_EQ(values.reduce(list_parallel::par, 0.0), sequential);
+
+	list<std::string> words{ "a", "b", "c", "d", "e" };
+	EXPECT_EQ(words.reduce(large, words.make_split_index(5), std::string(">")), ">abcde");
+}
+
+TEST(parallel_algorithms, shouldFindFirstMatchAndCancelLaterChunks)
+{
+	list_parallel::thread_pool pool(4);
+	list<int> values = makeSequence(200000);
+	std::atomic<std::size_t> calls{ 0 };
+
+	auto it = values.find_if(pool, [&](int e) { ++calls; return e % 1000 == 999; });
+	ASSERT_NE(it, values.end());
+	EXPECT_EQ(*it, 999);
+	EXPECT_LT(calls.load(), values.size());
+
+	EXPECT_EQ(*values.find(pool, 123456), 123456);
+	EXPECT_EQ(values.find(pool, -1), values.end());
+	EXPECT_EQ(std::as_const(values).find_if(list_parallel::par, [](int e) { return e > 150000; }), std::next(values.cbegin(), 150001));
+}
+
+TEST(parallel_algorithms, shouldReuseSplitIndexUntilListChanges)
+{
+	list_parallel::thread_pool pool(2);
+	list<int> values = makeSequence(10000);
+	const auto index = values.make_split_index(8);
+	EXPECT_EQ(index.parts(), 8);
+	EXPECT_EQ(values.count_if(pool, index, [](int e) { return e < 100; }), 100);
+
+	values.transform(pool, index, [](int e) { return -e; });
+	EXPECT_EQ(values.count_if(pool, index, [](int e) { return e <= 0; }), 10000);
+
+	values.push_back(1);
+	EXPECT_THROW((void)values.count_if(pool, index, [](int) { return true; }), std::invalid_argument);
+	list<int> other = makeSequence(10000);
+	EXPECT_THROW((void)other.count_if(pool, index, [](int) { return true; }), std::invalid_argument);
+}
+
+TEST(parallel_algorithms, shouldRejectSplitIndexAfterInteriorChanges)
+{
+	list_parallel::thread_pool pool(2);
+	list<int, list_stats::maintenance> values;
+	for (int i = 0; i < 1000; i++)
+		values.push_back(i);
+
+	auto index = values.make_split_index(4);
+	values.pop(std::next(values.begin(), 500));
+	values.emplace(std::next(values.begin(), 250), -1);
+	EXPECT_THROW((void)values.count_if(pool, index, [](int) { return true; }), std::invalid_argument);
+
+	index = values.make_split_index(4);
+	values.sort();
+	EXPECT_THROW((void)values.count_if(pool, index, [](int) { return true; }), std::invalid_argument);
+
+	index = values.make_split_index(4);
+	values.radix_sort();
+	EXPECT_THROW((void)values.count_if(pool, index, [](int) { return true; }), std::invalid_argument);
+
+	index = values.make_split_index(4);
+	values.merge_sort(std::greater<>{});
+	EXPECT_THROW((void)values.count_if(pool, index, [](int) { return true; }), std::invalid_argument);
+
+	index = values.make_split_index(4);
+	values.defragment();
+	EXPECT_THROW((void)values.count_if(pool, index, [](int) { return true; }), std::invalid_argument);
+
+	index = values.make_split_index(4);
+	EXPECT_EQ(values.count_if(pool, index, [](int) { return true; }), 1000);
+}
+
+TEST(parallel_algorithms, shouldPropagateExceptionsFromWorkers)
+{
+	list_parallel::thread_pool pool(4);
+	list<int> values = makeSequence(100000);
+	EXPECT_THROW(values.for_each(pool, [](int e)
+		{
+			if (e == 77777)
+				throw std::runtime_error("bad element");
+		}), std::runtime_error);
+
+	EXPECT_EQ(values.count_if(pool, [](int e) { return e >= 0; }), 100000);
+}
+
+TEST(parallel_algorithms, shouldRunNestedWorkInline)
+{
+	list_parallel::thread_pool pool(3);
+	list<int> outer = makeSequence(64);
+	const list<int> inner = makeSequence(1000);
+	std::atomic<std::size_t> total{ 0 };
+	outer.for_each(pool, outer.make_split_index(16), [&](int)
+		{
+			total += inner.count_if(pool, inner.make_split_index(4), [](int e) { return e % 10 == 0; });
+		});
+	EXPECT_EQ(total.load(), 64 * 100);
+}
+
+#if defined(LIST_TEST_STD_EXECUTION)
+TEST(parallel_algorithms, shouldAcceptStandardExecutionPolicies)
+{
+	list<int> values = makeSequence(20000);
+	EXPECT_EQ(values.count_if(std::execution::par, [](int e) { return e % 4 == 0; }), 5000);
+	EXPECT_EQ(values.reduce(std::execution::seq, 0LL), values.accumulate(0LL));
+	EXPECT_EQ(*values.find(std::execution::par_unseq, 19999), 19999);
+}
+#endif
@@ -0,0 +1,243 @@
+#include <gtest/gtest.h>
+#include "../list/persistent_list.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+
+using intpersistentlist = persistent_list<int>;
+
+namespace
+{
+	std::string freshPath(const std::string& name)
+	{
+		const std::string path = testing::TempDir() + "persistent_list_" + name + "_" + std::to_string(::getpid());
+		std::remove(path.c_str());
+		return path;
+	}
+
+	std::vector<int> contents(const intpersistentlist& list)
+	{
+		return std::vector<int>(list.begin(), list.end());
+	}
+}
+
+// open and reopen
+
+TEST(persistent_list_open, shouldStartEmpty)
+{
+	const std::string path = freshPath("empty");
+	intpersistentlist list(path);
+	EXPECT_TRUE(list.empty());
+	EXPECT_FALSE(list.recovered());
+	EXPECT_TRUE(list.begin() == list.end());
+	std::remove(path.c_str());
+}
+
+TEST(persistent_list_open, shouldKeepContentsAcrossReopen)
+{
+	const std::string path = freshPath("reopen");
+	{
+		intpersistentlist list(path);
+		for (int i = 0; i < 10; i++)
+			list.push_back(i);
+		list.push_front(-1);
+	}
+
+	intpersistentlist reopened(path);
+	EXPECT_FALSE(reopened.recovered());
+	EXPECT_EQ(reopened.size(), 11);
+	EXPECT_EQ(reopened.front(), -1);
+	EXPECT_EQ(reopened.back(), 9);
+	EXPECT_EQ(reopened.accumulate(0), 44);
+	std::remove(path.c_str());
+}
+
+TEST(persistent_list_open, shouldRejectMismatchedValueType)
+{
+	const std::string path = freshPath("mismatch");
+	{
+		intpersistentlist list(path);
+		list.push_back(1);
+	}
+
+	EXPECT_THROW(persistent_list<double> other(path), std::runtime_error);
+	std::remove(path.c_str());
+}
+
+TEST(persistent_list_open, shouldGrowFileAndKeepLinksValid)
+{
+	const std::string path = freshPath("grow");
+	{
+		intpersistentlist list(path);
+		const std::size_t initial = list.capacity();
+		for (int i = 0; i < 100000; i++)
+			list.push_back(i);
+		EXPECT_GT(list.capacity(), initial);
+	}
+
+	intpersistentlist reopened(path);
+	EXPECT_EQ(reopened.size(), 100000);
+	EXPECT_EQ(reopened.accumulate(0LL), 4999950000LL);
+	std::remove(path.c_str());
+}
+
+// modifications in place
+
+TEST(persistent_list_modify, shouldInsertAndPopInPlace)
+{
+	const std::string path = freshPath("modify");
+	intpersistentlist list(path);
+	for (int i = 0; i < 5; i++)
+		list.push_back(i);
+
+	auto it = list.find(2);
+	it = list.insert(it, 42);
+	EXPECT_EQ(*it, 42);
+	it = list.pop(++it);
+	EXPECT_EQ(*it, 3);
+
+	list.pop_front();
+	list.pop_back();
+	EXPECT_EQ(contents(list), (std::vector<int>{ 1, 42, 3 }));
+	EXPECT_THROW((void)list.pop(list.end()), std::runtime_error);
+	std::remove(path.c_str());
+}
+
+TEST(persistent_list_modify, shouldEraseRange)
+{
+	const std::string path = freshPath("erase");
+	intpersistentlist list(path);
+	for (int i = 0; i < 8; i++)
+		list.push_back(i);
+
+	auto first = list.find(2);
+	auto last = list.find(6);
+	EXPECT_TRUE(list.erase(first, last) == last);
+	EXPECT_EQ(contents(list), (std::vector<int>{ 0, 1, 6, 7 }));
+	EXPECT_THROW((void)list.erase(last, list.find(1)), std::runtime_error);
+	std::remove(path.c_str());
+}
+
+TEST(persistent_list_modify, shouldPushOwnElementAcrossGrowth)
+{
+	const std::string path = freshPath("self");
+	intpersistentlist list(path);
+	list.push_back(7);
+	const std::size_t initial = list.capacity();
+	while (list.capacity() == initial)
+		list.push_back(list.front());
+	list.push_front(list.back());
+	EXPECT_EQ(list.size(), initial + 2);
+	EXPECT_EQ(list.accumulate(std::size_t(0)), 7 * (initial + 2));
+	std::remove(path.c_str());
+}
+
+TEST(persistent_list_modify, shouldReuseFreedSlots)
+{
+	const std::string path = freshPath("reuse");
+	intpersistentlist list(path);
+	const std::size_t capacity = list.capacity();
+	for (std::size_t round = 0; round < 4 * capacity; round++)
+	{
+		list.push_back(int(round));
+		list.pop_front();
+	}
+	EXPECT_EQ(list.capacity(), capacity);
+	EXPECT_TRUE(list.empty());
+	std::remove(path.c_str());
+}
+
+TEST(persistent_list_modify, shouldClearInConstantTime)
+{
+	const std::string path = freshPath("clear");
+	intpersistentlist list(path);
+	for (int i = 0; i < 1000; i++)
+		list.push_back(i);
+	list.clear();
+	EXPECT_TRUE(list.empty());
+	list.push_back(5);
+	EXPECT_EQ(contents(list), (std::vector<int>{ 5 }));
+	std::remove(path.c_str());
+}
+
+TEST(persistent_list_modify, shouldThrowOnEmptyAccess)
+{
+	const std::string path = freshPath("emptyaccess");
+	intpersistentlist list(path);
+	EXPECT_THROW((void)list.front(), std::length_error);
+	EXPECT_THROW(list.pop_back(), std::length_error);
+	EXPECT_THROW((void)*list.begin(), std::runtime_error);
+	std::remove(path.c_str());
+}
+
+// crash recovery
+
+TEST(persistent_list_recovery, shouldRecoverAfterProcessDiesWithoutCheckpoint)
+{
+	const std::string path = freshPath("crash");
+	{
+		intpersistentlist list(path);
+		list.push_back(1);
+		list.push_back(2);
+	}
+
+	const pid_t child = ::fork();
+	ASSERT_GE(child, 0);
+	if (child == 0)
+	{
+		intpersistentlist* list = new intpersistentlist(path, intpersistentlist::durability::ordered);
+		list->push_back(3);
+		list->pop_front();
+		list->push_front(0);
+		::_exit(0);
+	}
+
+	int status = 0;
+	ASSERT_EQ(::waitpid(child, &status, 0), child);
+
+	intpersistentlist reopened(path);
+	EXPECT_TRUE(reopened.recovered());
+	EXPECT_EQ(contents(reopened), (std::vector<int>{ 0, 2, 3 }));
+	reopened.push_back(4);
+	EXPECT_EQ(reopened.size(), 4);
+	std::remove(path.c_str());
+}
+
+TEST(persistent_list_recovery, shouldRebuildBackLinksFromForwardChain)
+{
+	const std::string path = freshPath("backlinks");
+	const pid_t child = ::fork();
+	ASSERT_GE(child, 0);
+	if (child == 0)
+	{
+		intpersistentlist* list = new intpersistentlist(path);
+		for (int i = 0; i < 100; i++)
+			list->push_back(i);
+		for (int i = 0; i < 50; i++)
+			list->pop_front();
+		::_exit(0);
+	}
+
+	int status = 0;
+	ASSERT_EQ(::waitpid(child, &status, 0), child);
+
+	intpersistentlist reopened(path);
+	EXPECT_TRUE(reopened.recovered());
+	EXPECT_EQ(reopened.size(), 50);
+	EXPECT_EQ(reopened.back(), 99);
+
+	int expected = 99;
+	for (auto it = --reopened.end();; --it)
+	{
+		EXPECT_EQ(*it, expected--);
+		if (it == reopened.begin())
+			break;
+	}
+
+	const std::size_t capacity = reopened.capacity();
+	for (int i = 0; i < 50; i++)
+		reopened.push_back(i);
+	EXPECT_EQ(reopened.capacity(), capacity);
+	std::remove(path.c_str());
+}
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include "../list/serialization.h"
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include <string>
+
+namespace
+{
+	struct point
+	{
+		int x;
+		int y;
+		bool operator==(const point&) const = default;
+	};
+
+	struct label
+	{
+		std::string text;
+		int weight;
+		bool operator==(const label&) const = default;
+	};
+
+	template<typename T>
+	list<T> roundTrip(const list<T>& source)
+	{
+		std::stringstream buffer;
+		list_io::save(source, buffer);
+		list<T> loaded;
+		list_io::load(loaded, buffer);
+		return loaded;
+	}
+}
+
+template<>
+struct list_io::serializer<label>
+{
+	static void write(writer& out, const label& value)
+	{
+		serializer<std::string>::write(out, value.text);
+		out.write_raw(value.weight);
+	}
+
+	static label read(reader& in)
+	{
+		std::string text = serializer<std::string>::read(in);
+		return { std::move(text), in.read_raw<int>() };
+	}
+};
+
+// encodings
+
+TEST(serialization_encoding, shouldPickEncodingFromType)
+{
+	EXPECT_EQ(list_io::encoding_of<int>(), list_io::encoding::delta_varint);
+	EXPECT_EQ(list_io::encoding_of<std::uint64_t>(), list_io::encoding::delta_varint);
+	EXPECT_EQ(list_io::encoding_of<double>(), list_io::encoding::raw);
+	EXPECT_EQ(list_io::encoding_of<point>(), list_io::encoding::raw);
+	EXPECT_EQ(list_io::encoding_of<std::string>(), list_io::encoding::custom);
+	EXPECT_EQ(list_io::encoding_of<label>(), list_io::encoding::custom);
+}
+
+TEST(serialization_encoding, shouldStoreSortedIntegersCompactly)
+{
+	list<int> source;
+	for (int i = 0; i < 10000; i++)
+		source.push_back(1000000 + i * 3);
+
+	std::stringstream buffer;
+	list_io::save(source, buffer);
+
+	EXPECT_LT(buffer.str().size(), source.size() * 2);
+}
+
+// round trips
+
+TEST(serialization_roundtrip, shouldRoundTripEmptyList)
+{
+	list<int> source;
+	list<int> loaded = roundTrip(source);
+	EXPECT_TRUE(loaded.empty());
+}
+
+TEST(serialization_roundtrip, shouldRoundTripIntegralExtremes)
+{
+	list<std::int64_t> source{ 0, -1, 1, std::numeric_limits<std::int64_t>::min(),
+		std::numeric_limits<std::int64_t>::max(), -5, 42 };
+	EXPECT_TRUE(roundTrip(source) == source);
+
+	list<std::uint64_t> unsignedSource{ 0, std::numeric_limits<std::uint64_t>::max(), 7, 1u << 31 };
+	EXPECT_TRUE(roundTrip(unsignedSource) == unsignedSource);
+
+	list<std::int8_t> narrow{ -128, 127, 0, -1 };
+	EXPECT_TRUE(roundTrip(narrow) == narrow);
+}
+
+TEST(serialization_roundtrip, shouldRoundTripRawValues)
+{
+	list<double> doubles{ 1.5, -2.25, 0.0, 1e300 };
+	EXPECT_TRUE(roundTrip(doubles) == doubles);
+
+	list<point> points;
+	for (int i = 0; i < 100000; i++)
+		points.push_back({ i, -i });
+	EXPECT_TRUE(roundTrip(points) == points);
+}
+
+TEST(serialization_roundtrip, shouldRoundTripCustomTypes)
+{
+	list<std::string> strings{ "", "a", std::string(100000, 'x'), "tail" };
+	EXPECT_TRUE(roundTrip(strings) == strings);
+
+	list<label> labels{ { "first", 1 }, { "", -2 }, { "third", 3 } };
+	EXPECT_TRUE(roundTrip(labels) == labels);
+}
+
+TEST(serialization_roundtrip, shouldReplaceExistingContents)
+{
+	list<int> source{ 1, 2, 3 };
+	std::stringstream buffer;
+	list_io::save(source, buffer);
+
+	list<int> target{ 9, 9, 9, 9 };
+	list_io::load(target, buffer);
+	EXPECT_TRUE(target == source);
+}
+
+TEST(serialization_roundtrip, shouldReadConsecutiveListsFromOneStream)
+{
+	list<int> first{ 1, 2, 3 };
+	list<int> second{ 4, 5 };
+	std::stringstream buffer;
+	list_io::save(first, buffer);
+	list_io::save(second, buffer);
+
+	list<int> loadedFirst;
+	list<int> loadedSecond;
+	list_io::load(loadedFirst, buffer);
+	list_io::load(loadedSecond, buffer);
+	EXPECT_TRUE(loadedFirst == first);
+	EXPECT_TRUE(loadedSecond == second);
+}
+
+TEST(serialization_roundtrip, shouldRoundTripThroughFileDescriptor)
+{
+	std::FILE* file = std::tmpfile();
+	ASSERT_NE(file, nullptr);
+	const int fd = fileno(file);
+
+	list<int> source;
+	for (int i = 0; i < 200000; i++)
+		source.push_back(i % 2 ? i : -i);
+	list_io::save(source, fd);
+
+	ASSERT_EQ(lseek(fd, 0, SEEK_SET), 0);
+	list<int> loaded;
+	list_io::load(loaded, fd);
+	std::fclose(file);
+
+	EXPECT_TRUE(loaded == source);
+}
+
+TEST(serialization_roundtrip, shouldLoadIntoDefragmentedLayout)
+{
+	list<int> source;
+	for (int i = 0; i < 5000; i++)
+		source.push_back(i);
+
+	list<int> loaded = roundTrip(source);
+	EXPECT_GT(loaded.locality_score(), 0.9);
+}
+
+// errors
+
+TEST(serialization_errors, shouldRejectBadMagic)
+{
+	std::stringstream buffer("NOPE and some more bytes here");
+	list<int> target;
+	EXPECT_THROW(list_io::load(target, buffer), std::runtime_error);
+}
+
+TEST(serialization_errors, shouldRejectMismatchedType)
+{
+	list<double> source{ 1.0, 2.0 };
+	std::stringstream buffer;
+	list_io::save(source, buffer);
+
+	list<int> target;
+	EXPECT_THROW(list_io::load(target, buffer), std::runtime_error);
+}
+
+TEST(serialization_errors, shouldRejectTruncatedDataAndKeepTarget)
+{
+	list<int> source;
+	for (int i = 0; i < 1000; i++)
+		source.push_back(i * 1000);
+	std::stringstream buffer;
+	list_io::save(source, buffer);
+
+	std::string data = buffer.str();
+	std::stringstream truncated(data.substr(0, data.size() / 2));
+
+	list<int> target{ 7 };
+	EXPECT_THROW(list_io::load(target, truncated), std::runtime_error);
+	EXPECT_EQ(target.size(), 1);
+	EXPECT_EQ(target.front(), 7);
+}
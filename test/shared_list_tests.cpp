@@ -0,0 +1,294 @@
+#include <gtest/gtest.h>
+#include "../list/shared_list.h"
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using intsharedlist = shared_list<int>;
+
+namespace
+{
+	intsharedlist makeSequence(int count)
+	{
+		intsharedlist list;
+		for (int i = 0; i < count; i++)
+			list.push_back(i);
+		return list;
+	}
+
+	bool matches(const intsharedlist& list, const std::vector<int>& expected)
+	{
+		return list.size() == expected.size() && std::equal(list.begin(), list.end(), expected.begin(), expected.end());
+	}
+}
+
+// copies
+
+TEST(shared_list_copy, shouldShareStorageUntilFirstMutation)
+{
+	intsharedlist original = makeSequence(640);
+	intsharedlist snapshot(original);
+
+	EXPECT_EQ(original.use_count(), 2);
+	EXPECT_EQ(snapshot, original);
+	EXPECT_EQ(original.segment_count(), 10);
+
+	snapshot.push_back(640);
+	EXPECT_EQ(original.use_count(), 1);
+	EXPECT_EQ(snapshot.segment_count(), 11);
+	EXPECT_EQ(snapshot.shared_segment_count(), 10);
+	EXPECT_EQ(original.size(), 640);
+	EXPECT_EQ(snapshot.size(), 641);
+	EXPECT_EQ(original.back(), 639);
+	EXPECT_EQ(snapshot.back(), 640);
+}
+
+TEST(shared_list_copy, shouldDetachOnlyTheChangedSegment)
+{
+	intsharedlist original = makeSequence(640);
+	intsharedlist snapshot = original;
+
+	auto changed = snapshot.update(std::next(snapshot.begin(), 200), [](int& value) { value = -1; });
+	EXPECT_EQ(*changed, -1);
+	EXPECT_EQ(snapshot.shared_segment_count(), 9);
+	EXPECT_EQ(*std::next(original.begin(), 200), 200);
+	EXPECT_EQ(*std::next(snapshot.begin(), 200), -1);
+
+	snapshot.pop(std::next(snapshot.begin(), 500));
+	EXPECT_EQ(snapshot.shared_segment_count(), 8);
+	EXPECT_EQ(original.size(), 640);
+	EXPECT_EQ(*std::next(original.begin(), 500), 500);
+	EXPECT_EQ(*std::next(snapshot.begin(), 500), 501);
+}
+
+TEST(shared_list_copy, shouldShareDonatedSegmentsOnSplice)
+{
+	intsharedlist target{ 1, 2, 3 };
+	intsharedlist donor = makeSequence(128);
+	intsharedlist keep = donor;
+
+	target.splice(target.begin(), donor);
+	EXPECT_TRUE(donor.empty());
+	EXPECT_EQ(target.size(), 131);
+	EXPECT_EQ(*std::next(target.begin()), 0);
+	EXPECT_EQ(target.back(), 3);
+	EXPECT_EQ(target.shared_segment_count(), keep.segment_count());
+	EXPECT_EQ(keep.size(), 128);
+
+	intsharedlist front{ -2, -1 };
+	target.splice(target.end(), front);
+	EXPECT_EQ(target.front(), -2);
+	EXPECT_EQ(target.size(), 133);
+}
+
+TEST(shared_list_copy, shouldSpliceSnapshotIntoItsSource)
+{
+	intsharedlist original = makeSequence(100);
+	intsharedlist snapshot = original;
+
+	original.splice(std::next(original.begin(), 49), snapshot);
+	EXPECT_TRUE(snapshot.empty());
+
+	std::vector<int> expected(200);
+	std::iota(expected.begin(), expected.begin() + 50, 0);
+	std::iota(expected.begin() + 50, expected.begin() + 150, 0);
+	std::iota(expected.begin() + 150, expected.end(), 50);
+	EXPECT_TRUE(matches(original, expected));
+
+	original.update(std::next(original.begin(), 120), [](int& value) { value = -1; });
+	expected[120] = -1;
+	EXPECT_TRUE(matches(original, expected));
+	EXPECT_EQ(*std::next(original.begin(), 170), 70);
+}
+
+TEST(shared_list_copy, shouldDetachWholeChainOnlyWhereBulkOperationsChange)
+{
+	intsharedlist original = makeSequence(640);
+	intsharedlist snapshot = original;
+
+	EXPECT_EQ(snapshot.remove_if([](int e) { return e >= 600; }), 40);
+	EXPECT_EQ(snapshot.shared_segment_count(), 9);
+
+	snapshot.transform([](int e) { return e * 2; });
+	EXPECT_EQ(snapshot.shared_segment_count(), 0);
+	EXPECT_EQ(snapshot.back(), 1198);
+	EXPECT_EQ(original.back(), 639);
+	EXPECT_EQ(original.shared_segment_count(), 0);
+}
+
+TEST(shared_list_copy, shouldCallRemovePredicateOncePerElement)
+{
+	intsharedlist original = makeSequence(640);
+	intsharedlist snapshot = original;
+
+	int calls = 0;
+	EXPECT_EQ(snapshot.remove_if([&](int e) { ++calls; return e % 100 == 50; }), 6);
+	EXPECT_EQ(calls, 640);
+	EXPECT_EQ(original.size(), 640);
+
+	calls = 0;
+	EXPECT_EQ(snapshot.remove_if([&](int e) { ++calls; return e % 10 == 0; }), 58);
+	EXPECT_EQ(calls, 634);
+	EXPECT_EQ(snapshot.size(), 576);
+	EXPECT_EQ(std::count_if(snapshot.begin(), snapshot.end(), [](int e) { return e % 10 == 0 || e % 100 == 50; }), 0);
+}
+
+TEST(shared_list_copy, shouldStayConsistentWhenRemovePredicateThrows)
+{
+	intsharedlist original = makeSequence(640);
+	intsharedlist snapshot = original;
+
+	EXPECT_THROW(snapshot.remove_if([](int e)
+		{
+			if (e == 300)
+				throw std::runtime_error("predicate failed");
+			return e < 200 || e % 2 == 0;
+		}), std::runtime_error);
+
+	std::vector<int> expected;
+	for (int i = 200; i < 640; i++)
+		if (i >= 300 || i % 2 != 0)
+			expected.push_back(i);
+	EXPECT_TRUE(matches(snapshot, expected));
+	EXPECT_EQ(std::size_t(std::distance(snapshot.begin(), snapshot.end())), snapshot.size());
+	EXPECT_EQ(original.size(), 640);
+
+	snapshot.push_front(-1);
+	EXPECT_EQ(snapshot.front(), -1);
+	EXPECT_EQ(snapshot.size(), expected.size() + 1);
+}
+
+// mutation
+
+TEST(shared_list_mutation, shouldMatchVectorUnderRandomEditsWithSnapshots)
+{
+	std::mt19937 generator(5);
+	intsharedlist list;
+	std::vector<int> mirror;
+	std::vector<std::pair<intsharedlist, std::vector<int>>> snapshots;
+
+	for (int step = 0; step < 3000; step++)
+	{
+		const std::size_t position = generator() % (mirror.size() + 1);
+		if (generator() % 3 != 0 || mirror.empty())
+		{
+			auto inserted = list.emplace(std::next(list.begin(), std::ptrdiff_t(position)), step);
+			EXPECT_EQ(*inserted, step);
+			mirror.insert(mirror.begin() + std::ptrdiff_t(position), step);
+		}
+		else
+		{
+			const std::size_t index = position % mirror.size();
+			auto next = list.pop(std::next(list.begin(), std::ptrdiff_t(index)));
+			mirror.erase(mirror.begin() + std::ptrdiff_t(index));
+			EXPECT_EQ(next, std::next(list.begin(), std::ptrdiff_t(index)));
+		}
+
+		if (step % 300 == 0)
+			snapshots.emplace_back(list, mirror);
+	}
+
+	EXPECT_TRUE(matches(list, mirror));
+	EXPECT_EQ(*std::prev(list.end()), mirror.back());
+	for (const auto& [snapshot, expected] : snapshots)
+		EXPECT_TRUE(matches(snapshot, expected));
+}
+
+TEST(shared_list_mutation, shouldHandleEndsAndEmptyLists)
+{
+	intsharedlist list;
+	EXPECT_THROW(list.pop_back(), std::length_error);
+	EXPECT_THROW((void)list.front(), std::length_error);
+	EXPECT_EQ(list.begin(), list.end());
+
+	list.push_front(2);
+	list.push_front(1);
+	list.push_back(3);
+	EXPECT_TRUE(matches(list, { 1, 2, 3 }));
+	list.pop_front();
+	list.pop_back();
+	EXPECT_TRUE(matches(list, { 2 }));
+	list.pop_back();
+	EXPECT_TRUE(list.empty());
+	EXPECT_EQ(list.segment_count(), 0);
+	EXPECT_THROW(list.pop(list.end()), std::length_error);
+}
+
+// threads
+
+TEST(shared_list_mutation, shouldMergeSmallOwnedSegments)
+{
+	intsharedlist list = makeSequence(640);
+	EXPECT_EQ(list.remove_if([](int e) { return e % 16 != 0; }), 600);
+	EXPECT_LT(list.segment_count(), 4);
+	std::vector<int> expected;
+	for (int i = 0; i < 640; i += 16)
+		expected.push_back(i);
+	EXPECT_TRUE(matches(list, expected));
+
+	intsharedlist popped = makeSequence(640);
+	for (auto it = popped.begin(); it != popped.end();)
+		it = *it % 32 == 0 ? std::next(it) : popped.pop(it);
+	EXPECT_LT(popped.segment_count(), 4);
+	EXPECT_EQ(popped.size(), 20);
+	EXPECT_EQ(*std::next(popped.begin(), 19), 608);
+
+	intsharedlist spliced = makeSequence(64);
+	for (int i = 0; i < 100; i++)
+	{
+		intsharedlist single{ -i };
+		spliced.splice(std::next(spliced.begin(), 32), single);
+	}
+	EXPECT_EQ(spliced.size(), 164);
+	EXPECT_LE(spliced.segment_count(), 8);
+	EXPECT_EQ(*std::next(spliced.begin(), 33), -99);
+}
+
+TEST(shared_list_mutation, shouldNotMergeSegmentsSharedWithSnapshots)
+{
+	intsharedlist original = makeSequence(640);
+	intsharedlist snapshot = original;
+	for (int i = 0; i < 60; i++)
+		snapshot.pop(std::next(snapshot.begin(), 64));
+
+	EXPECT_EQ(snapshot.segment_count(), 10);
+	EXPECT_EQ(snapshot.shared_segment_count(), 9);
+	EXPECT_EQ(*std::next(snapshot.begin(), 64), 124);
+	EXPECT_TRUE(matches(original, [] { std::vector<int> all(640); std::iota(all.begin(), all.end(), 0); return all; }()));
+}
+
+TEST(shared_list_threads, shouldReadSnapshotsWhileTheOriginalChanges)
+{
+	intsharedlist original = makeSequence(4096);
+	const long long expected = 4095LL * 4096 / 2;
+
+	std::vector<std::thread> readers;
+	std::vector<long long> totals(4, 0);
+	for (std::size_t i = 0; i < totals.size(); i++)
+		readers.emplace_back([snapshot = intsharedlist(original), &total = totals[i]]
+			{
+				for (int round = 0; round < 20; round++)
+				{
+					intsharedlist local = snapshot;
+					long long sum = 0;
+					local.for_each([&](int e) { sum += e; });
+					total = sum;
+				}
+			});
+
+	for (int i = 0; i < 2000; i++)
+	{
+		original.update(std::next(original.begin(), i % 64), [](int& e) { ++e; });
+		original.push_front(i);
+		original.pop_back();
+	}
+
+	for (std::thread& reader : readers)
+		reader.join();
+	for (long long total : totals)
+		EXPECT_EQ(total, expected);
+}
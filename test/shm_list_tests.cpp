@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+#include "../list/shm_list.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+using intshmlist = shm_list<int>;
+
+namespace
+{
+	std::string segmentName(const std::string& name)
+	{
+		const std::string full = "/shm_list_" + name + "_" + std::to_string(::getpid());
+		intshmlist::remove(full);
+		return full;
+	}
+
+	std::vector<int> contents(const intshmlist& list)
+	{
+		std::vector<int> result;
+		list.for_each([&](int e) { result.push_back(e); });
+		return result;
+	}
+
+	bool childSucceeded(pid_t child)
+	{
+		int status = 0;
+		return ::waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+	}
+
+	void corruptHighWater(const std::string& name)
+	{
+		const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+		ASSERT_GE(fd, 0);
+		void* mapped = ::mmap(nullptr, 4 * sizeof(std::uint64_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		::close(fd);
+		ASSERT_NE(mapped, MAP_FAILED);
+		static_cast<std::uint64_t*>(mapped)[2] = ~std::uint64_t(0);
+		::munmap(mapped, 4 * sizeof(std::uint64_t));
+	}
+
+	struct work_item
+	{
+		int id;
+		double payload[3];
+	};
+}
+
+// single process
+
+TEST(shm_list_local, shouldPushAndPopOnBothEnds)
+{
+	const std::string name = segmentName("local");
+	intshmlist list(name, 16);
+	list.push_back(2);
+	list.push_back(3);
+	list.push_front(1);
+	EXPECT_EQ(contents(list), (std::vector<int>{ 1, 2, 3 }));
+
+	list.pop_back();
+	EXPECT_EQ(list.try_pop_front(), 1);
+	EXPECT_EQ(list.size(), 1);
+	list.clear();
+	EXPECT_TRUE(list.empty());
+	EXPECT_EQ(list.try_pop_front(), std::nullopt);
+	EXPECT_THROW(list.pop_front(), std::length_error);
+	intshmlist::remove(name);
+}
+
+TEST(shm_list_local, shouldEnforceCapacityAndReuseSlots)
+{
+	const std::string name = segmentName("capacity");
+	intshmlist list(name, 4);
+	for (int i = 0; i < 4; i++)
+		EXPECT_TRUE(list.try_emplace_back(i));
+	EXPECT_FALSE(list.try_emplace_back(4));
+	EXPECT_THROW(list.push_front(4), std::length_error);
+
+	for (int round = 0; round < 100; round++)
+	{
+		list.pop_front();
+		list.push_back(round);
+	}
+	EXPECT_EQ(contents(list), (std::vector<int>{ 96, 97, 98, 99 }));
+	intshmlist::remove(name);
+}
+
+TEST(shm_list_local, shouldConsumeInPlace)
+{
+	const std::string name = segmentName("consume");
+	shm_list<work_item> list(name, 8);
+	list.emplace_back(work_item{ 7, { 1.0, 2.0, 3.0 } });
+
+	double total = 0;
+	EXPECT_TRUE(list.consume_front([&](const work_item& item) { total = item.id + item.payload[2]; }));
+	EXPECT_EQ(total, 10.0);
+	EXPECT_FALSE(list.consume_front([](const work_item&) {}));
+	shm_list<work_item>::remove(name);
+}
+
+TEST(shm_list_local, shouldRejectDuplicateCreateAndMissingOpen)
+{
+	const std::string name = segmentName("duplicate");
+	intshmlist list(name, 4);
+	EXPECT_THROW(intshmlist(name, 4), std::system_error);
+	EXPECT_THROW(shm_list<double> other(name), std::runtime_error);
+	intshmlist::remove(name);
+	EXPECT_THROW(intshmlist other(name), std::system_error);
+}
+
+// across processes
+
+TEST(shm_list_ipc, shouldOpenSegmentByNameInChild)
+{
+	const std::string name = segmentName("byname");
+	intshmlist list(name, 32);
+
+	const pid_t child = ::fork();
+	ASSERT_GE(child, 0);
+	if (child == 0)
+	{
+		intshmlist opened(name);
+		for (int i = 0; i < 10; i++)
+			opened.push_back(i);
+		::_exit(0);
+	}
+
+	ASSERT_TRUE(childSucceeded(child));
+	EXPECT_EQ(list.size(), 10);
+	EXPECT_EQ(list.accumulate(0), 45);
+	intshmlist::remove(name);
+}
+
+TEST(shm_list_ipc, shouldHandOffItemsFromProducerToConsumer)
+{
+	const std::string name = segmentName("handoff");
+	intshmlist list(name, 64);
+	constexpr int items = 20000;
+
+	const pid_t producer = ::fork();
+	ASSERT_GE(producer, 0);
+	if (producer == 0)
+	{
+		for (int i = 0; i < items; i++)
+			list.push_back_wait(i);
+		::_exit(0);
+	}
+
+	bool ordered = true;
+	long long total = 0;
+	for (int i = 0; i < items; i++)
+	{
+		const int value = list.pop_front_wait();
+		ordered &= value == i;
+		total += value;
+	}
+
+	ASSERT_TRUE(childSucceeded(producer));
+	EXPECT_TRUE(ordered);
+	EXPECT_EQ(total, (long long)items * (items - 1) / 2);
+	EXPECT_TRUE(list.empty());
+	intshmlist::remove(name);
+}
+
+TEST(shm_list_ipc, shouldServeSeveralConsumers)
+{
+	const std::string name = segmentName("consumers");
+	shm_list<long long> results(name + "_results", 8);
+	intshmlist list(name, 128);
+	constexpr int consumers = 3;
+	constexpr int items = 3000;
+
+	std::vector<pid_t> children;
+	for (int c = 0; c < consumers; c++)
+	{
+		const pid_t child = ::fork();
+		ASSERT_GE(child, 0);
+		if (child == 0)
+		{
+			long long total = 0;
+			for (;;)
+			{
+				const int value = list.pop_front_wait();
+				if (value < 0)
+					break;
+				total += value;
+			}
+			results.push_back(total);
+			::_exit(0);
+		}
+		children.push_back(child);
+	}
+
+	for (int i = 0; i < items; i++)
+		list.push_back_wait(i);
+	for (int c = 0; c < consumers; c++)
+		list.push_back_wait(-1);
+
+	for (pid_t child : children)
+		ASSERT_TRUE(childSucceeded(child));
+	EXPECT_EQ(results.size(), consumers);
+	EXPECT_EQ(results.accumulate(0LL), (long long)items * (items - 1) / 2);
+	intshmlist::remove(name);
+	shm_list<long long>::remove(name + "_results");
+}
+
+TEST(shm_list_ipc, shouldRecoverWhenLockOwnerDies)
+{
+	const std::string name = segmentName("ownerdead");
+	intshmlist list(name, 16);
+	for (int i = 0; i < 5; i++)
+		list.push_back(i);
+
+	const pid_t child = ::fork();
+	ASSERT_GE(child, 0);
+	if (child == 0)
+	{
+		list.for_each([](int) { ::_exit(0); });
+		::_exit(1);
+	}
+
+	ASSERT_TRUE(childSucceeded(child));
+	list.push_back(5);
+	EXPECT_EQ(contents(list), (std::vector<int>{ 0, 1, 2, 3, 4, 5 }));
+	intshmlist::remove(name);
+}
+
+TEST(shm_list_ipc, shouldReleaseTheLockWhenRepairFails)
+{
+	const std::string name = segmentName("repairfails");
+	intshmlist list(name, 16);
+	list.push_back(1);
+
+	const pid_t child = ::fork();
+	ASSERT_GE(child, 0);
+	if (child == 0)
+	{
+		list.for_each([](int) { ::_exit(0); });
+		::_exit(1);
+	}
+
+	ASSERT_TRUE(childSucceeded(child));
+	corruptHighWater(name);
+	EXPECT_THROW(list.push_back(2), std::runtime_error);
+	EXPECT_THROW(list.push_back(2), std::system_error);
+	intshmlist::remove(name);
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include "../list/static_list.h"
+#include <memory>
+#include <string>
+
+using intstaticlist = static_list<int, 8>;
+
+namespace
+{
+	testing::AssertionResult compareList(const intstaticlist& list, const intstaticlist& list2)
+	{
+		if (list == list2)
+			return testing::AssertionSuccess();
+		else
+		{
+			auto fillStringWithList = [](std::string& str, const intstaticlist& target)
+				{
+					for (int e : target)
+						str.append(std::to_string(e) + " ");
+				};
+
+			std::string list1String;
+			std::string list2String;
+
+			fillStringWithList(list1String, list);
+			fillStringWithList(list2String, list2);
+
+			return testing::AssertionFailure() << "List 1: " << list1String
+				<< " List2: " << list2String;
+		}
+	}
+
+	auto isEven = [](int e) {return e % 2 == 0; };
+}
+
+// capacity
+
+TEST(static_list_capacity, tryEmplaceBackShouldFailWhenFull)
+{
+	intstaticlist list;
+	for (int i = 0; i < 8; i++)
+		EXPECT_TRUE(list.try_emplace_back(i));
+	EXPECT_TRUE(list.full());
+	EXPECT_FALSE(list.try_emplace_back(8));
+	EXPECT_FALSE(list.try_emplace_front(8));
+	EXPECT_EQ(list.size(), 8);
+	EXPECT_EQ(list.back(), 7);
+}
+
+TEST(static_list_capacity, pushBackShouldThrowWhenFull)
+{
+	static_list<int, 2> list{ 1,2 };
+	EXPECT_THROW(list.push_back(3), std::length_error);
+	EXPECT_EQ(list.size(), 2);
+}
+
+TEST(static_list_capacity, shouldReuseFreedSlots)
+{
+	static_list<int, 2> list;
+	for (int i = 0; i < 100; i++)
+	{
+		ASSERT_TRUE(list.try_emplace_back(i));
+		list.pop_front();
+	}
+	EXPECT_TRUE(list.empty());
+}
+
+TEST(static_list_capacity, tryInsertShouldReportFailure)
+{
+	static_list<int, 2> list{ 1,3 };
+	auto [it, inserted] = list.try_insert(++list.begin(), 2);
+	EXPECT_FALSE(inserted);
+	EXPECT_EQ(*it, 3);
+	list.pop_back();
+	auto [it2, inserted2] = list.try_insert(list.end(), 2);
+	EXPECT_TRUE(inserted2);
+	EXPECT_EQ(*it2, 2);
+}
+
+// push and pop
+
+TEST(static_list_push, shouldPushOnBothEnds)
+{
+	intstaticlist list;
+	list.push_back(2);
+	list.push_front(1);
+	list.emplace_back(3);
+	EXPECT_TRUE(compareList(list, intstaticlist{ 1,2,3 }));
+}
+
+TEST(static_list_pop, shouldThrowLengthErrorIfEmpty)
+{
+	intstaticlist list;
+	EXPECT_THROW(list.pop_back(), std::length_error);
+	EXPECT_THROW(list.pop_front(), std::length_error);
+	EXPECT_THROW(list.front(), std::length_error);
+}
+
+TEST(static_list_copy, shouldCopyAndMove)
+{
+	static_list<std::string, 4> list{ "a", "b" };
+	static_list<std::string, 4> copy = list;
+	static_list<std::string, 4> moved = std::move(list);
+	EXPECT_TRUE(copy == moved);
+	EXPECT_TRUE(list.empty());
+}
+
+// iterators and positional operations
+
+TEST(static_list_iterator, shouldTraverseBothDirections)
+{
+	intstaticlist list{ 1,2,3 };
+	auto it = list.begin();
+	EXPECT_EQ(*++it, 2);
+	EXPECT_EQ(*--it, 1);
+	EXPECT_EQ(*list.rbegin(), 3);
+	EXPECT_THROW(*list.end(), std::runtime_error);
+}
+
+TEST(static_list_insert, shouldInsertBeforeTheIteratorGiven)
+{
+	intstaticlist list{ 1,3 };
+	auto it = list.insert(++list.begin(), 2);
+	EXPECT_EQ(*it, 2);
+	EXPECT_TRUE(compareList(list, intstaticlist{ 1,2,3 }));
+}
+
+TEST(static_list_pop, shouldPopAtIteratorAndReturnNext)
+{
+	intstaticlist list{ 1,2,3 };
+	auto it = list.pop(++list.begin());
+	EXPECT_EQ(*it, 3);
+	EXPECT_THROW(list.pop(list.end()), std::runtime_error);
+}
+
+TEST(static_list_erase, shouldEraseTheRange)
+{
+	intstaticlist list{ 1,2,3,4,5 };
+	list.erase(++list.begin(), --list.end());
+	EXPECT_TRUE(compareList(list, intstaticlist{ 1,5 }));
+}
+
+TEST(static_list_splice, shouldSpliceAfterWhere)
+{
+	intstaticlist list{ 1,2,3 };
+	intstaticlist splicedlist{ 9,8,7 };
+	list.splice(list.begin(), splicedlist);
+	EXPECT_TRUE(compareList(list, intstaticlist{ 1,9,8,7,2,3 }));
+	EXPECT_TRUE(splicedlist.empty());
+}
+
+TEST(static_list_splice, shouldThrowIfCapacityExceeded)
+{
+	static_list<int, 3> list{ 1,2 };
+	static_list<int, 3> splicedlist{ 3,4 };
+	EXPECT_THROW(list.splice(list.begin(), splicedlist), std::length_error);
+	EXPECT_EQ(splicedlist.size(), 2);
+}
+
+// algorithms
+
+TEST(static_list_remove_if, shouldRemoveMatches)
+{
+	intstaticlist list{ 1,2,3,4,5,6 };
+	EXPECT_EQ(list.remove_if(isEven), 3);
+	EXPECT_TRUE(compareList(list, intstaticlist{ 1,3,5 }));
+}
+
+TEST(static_list_sort, shouldSortList)
+{
+	intstaticlist list{ 5,2,7,1,8,3,6,4 };
+	list.sort();
+	EXPECT_TRUE(compareList(list, intstaticlist{ 1,2,3,4,5,6,7,8 }));
+	EXPECT_EQ(*list.rbegin(), 8);
+	list.sort(std::greater<>());
+	EXPECT_EQ(list.front(), 8);
+	EXPECT_EQ(list.back(), 1);
+}
+
+TEST(static_list_traversal, findCountAccumulate)
+{
+	intstaticlist list{ 1,2,3,4 };
+	EXPECT_EQ(*list.find(3), 3);
+	EXPECT_TRUE(list.contains(4));
+	EXPECT_EQ(list.count_if(isEven), 2);
+	EXPECT_EQ(list.accumulate(0), 10);
+}
+
+// placement
+
+TEST(static_list_placement, shouldWorkInRawStorage)
+{
+	alignas(intstaticlist) std::byte storage[sizeof(intstaticlist)];
+	auto* list = new (storage) intstaticlist{ 1,2,3 };
+	list->pop_front();
+	EXPECT_EQ(list->front(), 2);
+	std::destroy_at(list);
+}
+
+TEST(static_list_placement, shouldNotStorePointers)
+{
+	static_assert(std::is_standard_layout_v<static_list<int, 100>>);
+	EXPECT_LE(sizeof(static_list<int, 100>), 102 * (sizeof(int) + 2 * sizeof(std::uint16_t)));
+}
@@ -1,6 +1,13 @@
 #include <gtest/gtest.h>
 #include "../list/list.h"
 #include "helpers/resource.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
 
 using intlist = list<int>;
 
@@ -30,6 +37,28 @@ namespace
 	}
 
 	auto isEven = [](int e) {return e % 2 == 0; };
+
+	template<class List>
+	void scatterNodes(List& list)
+	{
+		std::vector<typename List::node_handle> handles;
+		while (!list.empty())
+			handles.push_back(list.extract(list.begin()));
+
+		std::shuffle(handles.begin(), handles.end(), std::mt19937(42));
+		for (auto& handle : handles)
+			list.insert(list.end(), std::move(handle));
+	}
+
+	template<class List = intlist>
+	List makeScattered(int elements)
+	{
+		List list;
+		for (int i = 0; i < elements; i++)
+			list.push_back(i);
+		scatterNodes(list);
+		return list;
+	}
 }
 
 // initializer list
@@ -263,6 +292,21 @@ TEST(constructorByMovement, shouldUpdateNelms)
 	EXPECT_EQ(list2.size(), 3);
 }
 
+TEST(constructorByMovement, shouldMoveEmptyListWithoutStealingHead)
+{
+	intlist empty;
+	intlist moved = std::move(empty);
+	EXPECT_TRUE(moved.empty());
+	EXPECT_EQ(moved.begin(), moved.end());
+	moved.push_back(1);
+	EXPECT_TRUE(compareList(moved, intlist{ 1 }));
+
+	intlist source{ 1,2,3 };
+	intlist none = source.extract_if([](int e) { return e > 5; });
+	EXPECT_TRUE(none.empty());
+	EXPECT_EQ(source.size(), 3);
+}
+
 TEST_F(testResourceList, constructorByMovementshouldNotMakeCopies)
 {
 	listForTesting.emplace_back(testResource());
@@ -1067,6 +1111,338 @@ TEST(for_each, shouldForEachOnConstList)
 	EXPECT_TRUE(compareList(aux, list));
 }
 
+// traversal algorithms
+
+TEST(memberForEach, shouldVisitEveryElementInOrder)
+{
+	intlist list{ 1,2,3 };
+	intlist visited;
+	list.for_each([&](int e) { visited.push_back(e); });
+	EXPECT_TRUE(compareList(visited, list));
+}
+
+TEST(memberForEach, shouldAllowModifyingElements)
+{
+	intlist list{ 1,2,3 };
+	list.for_each([](int& e) { e *= 2; });
+	EXPECT_TRUE(compareList(list, intlist{ 2,4,6 }));
+}
+
+TEST(memberForEach, shouldWorkWithPrefetch)
+{
+	const intlist list{ 1,2,3 };
+	int total = 0;
+	list.for_each<8>([&](int e) { total += e; });
+	EXPECT_EQ(total, 6);
+	EXPECT_EQ(list.count_if<2>([](int e) { return e > 1; }), 2);
+}
+
+TEST(find, shouldReturnIteratorToFirstMatch)
+{
+	intlist list{ 1,2,3,2 };
+	auto it = list.find(2);
+	EXPECT_TRUE(it == ++(list.begin()));
+}
+
+TEST(find, shouldReturnEndIfNotFound)
+{
+	const intlist list{ 1,2,3 };
+	EXPECT_TRUE(list.find(5) == list.cend());
+}
+
+TEST(find_if, shouldReturnIteratorToFirstMatch)
+{
+	intlist list{ 1,3,4,6 };
+	EXPECT_EQ(*list.find_if(isEven), 4);
+}
+
+TEST(contains, shouldReturnTrueIfPresent)
+{
+	intlist list{ 1,2,3 };
+	EXPECT_TRUE(list.contains(3));
+	EXPECT_FALSE(list.contains(4));
+}
+
+TEST(count_if, shouldCountMatches)
+{
+	intlist list{ 1,2,3,4,6 };
+	EXPECT_EQ(list.count_if(isEven), 3);
+}
+
+TEST(accumulate, shouldSumElements)
+{
+	intlist list{ 1,2,3,4 };
+	EXPECT_EQ(list.accumulate(0), 10);
+}
+
+TEST(accumulate, shouldUseTheGivenOperation)
+{
+	intlist list{ 1,2,3,4 };
+	EXPECT_EQ(list.accumulate(1, std::multiplies<>()), 24);
+}
+
+TEST(accumulate, shouldWorkOnLongLists)
+{
+	intlist list;
+	for (int i = 0; i < 1000; i++)
+		list.push_back(i);
+	EXPECT_EQ(list.accumulate<32>(0L), 499500L);
+	EXPECT_EQ(list.accumulate<1>(0L), 499500L);
+}
+
+// vectorized reductions
+
+TEST(sum, shouldSumIntegers)
+{
+	intlist list;
+	for (int i = 1; i <= 1000; i++)
+		list.push_back(i);
+	EXPECT_EQ(list.sum(), 500500);
+}
+
+TEST(sum, shouldSumDoubles)
+{
+	list<double> list{ 0.5, 1.5, 2.0 };
+	EXPECT_DOUBLE_EQ(list.sum(), 4.0);
+}
+
+TEST(sum, shouldBeZeroIfListEmpty)
+{
+	list<float> emptylist;
+	EXPECT_EQ(emptylist.sum(), 0.0f);
+}
+
+TEST(minMax, shouldFindTheExtremes)
+{
+	intlist list;
+	for (int i = 0; i < 700; i++)
+		list.push_back((i * 37) % 701 - 350);
+	list.push_back(-1000);
+	list.push_front(1000);
+	EXPECT_EQ(list.min(), -1000);
+	EXPECT_EQ(list.max(), 1000);
+}
+
+TEST(minMax, shouldWorkWithFloats)
+{
+	list<float> list{ 3.5f, -1.25f, 8.0f, 2.0f };
+	EXPECT_EQ(list.min(), -1.25f);
+	EXPECT_EQ(list.max(), 8.0f);
+}
+
+TEST(minMax, shouldThrowLengthErrorIfListEmpty)
+{
+	intlist emptylist;
+	EXPECT_THROW((void)emptylist.min(), std::length_error);
+	EXPECT_THROW((void)emptylist.max(), std::length_error);
+}
+
+TEST(count, shouldCountOccurrences)
+{
+	intlist list;
+	for (int i = 0; i < 1000; i++)
+		list.push_back(i % 7);
+	EXPECT_EQ(list.count(3), 143);
+	EXPECT_EQ(list.count(9), 0);
+}
+
+TEST(count, shouldCountDoubles)
+{
+	list<double> list{ 1.0, 2.0, 1.0, 1.0 };
+	EXPECT_EQ(list.count(1.0), 3);
+}
+
+TEST(operatorEquality, shouldCompareLongLists)
+{
+	intlist list;
+	for (int i = 0; i < 1000; i++)
+		list.push_back(i);
+	intlist copy = list;
+	EXPECT_TRUE(list == copy);
+	copy.back() = -1;
+	EXPECT_FALSE(list == copy);
+}
+
+TEST(operatorThreeWay, shouldCompareLexicographically)
+{
+	EXPECT_TRUE((intlist{ 1,2,3 } <=> intlist{ 1,2,4 }) < 0);
+	EXPECT_TRUE((intlist{ 1,3 } <=> intlist{ 1,2,4 }) > 0);
+	EXPECT_TRUE((intlist{ 1,2 } <=> intlist{ 1,2,3 }) < 0);
+	EXPECT_TRUE((intlist{ 1,2,3 } <=> intlist{ 1,2,3 }) == 0);
+	EXPECT_TRUE(intlist{} < intlist{ 0 });
+}
+
+TEST(operatorThreeWay, shouldCompareNonArithmeticTypes)
+{
+	list<std::string> first{ "a", "b" };
+	list<std::string> second{ "a", "c" };
+	EXPECT_TRUE(first < second);
+	EXPECT_FALSE(first == second);
+}
+
+// locality and defragment
+
+TEST(locality, shouldBePerfectForSmallLists)
+{
+	intlist list{ 1 };
+	EXPECT_EQ(list.locality_score(), 1.0);
+}
+
+TEST(locality, shouldDropWhenNodesAreScattered)
+{
+	intlist list = makeScattered(4096);
+	EXPECT_LT(list.locality_score(), 0.1);
+	EXPECT_GT(list.locality().page_crossings, 0.0);
+}
+
+TEST(defragment, shouldKeepValuesAndOrder)
+{
+	intlist list = makeScattered(1000);
+	intlist expected(list.cbegin(), list.cend());
+	list.defragment();
+	EXPECT_TRUE(compareList(list, expected));
+	EXPECT_EQ(list.size(), 1000);
+}
+
+TEST(defragment, shouldRestoreLocality)
+{
+	intlist list = makeScattered(4096);
+	list.defragment();
+	EXPECT_GT(list.locality_score(), 0.99);
+}
+
+TEST(defragment, noProblemIfListEmpty)
+{
+	intlist emptylist;
+	emptylist.defragment();
+	EXPECT_TRUE(emptylist.empty());
+}
+
+TEST(defragment, shouldAllowMutationsAfterwards)
+{
+	intlist list = makeScattered(300);
+	list.defragment();
+	list.pop_front();
+	list.pop_back();
+	list.remove_if(isEven);
+	list.push_back(-1);
+	list.defragment();
+	EXPECT_EQ(list.back(), -1);
+	list.clear();
+	EXPECT_TRUE(list.empty());
+}
+
+TEST(defragment, nodesShouldOutliveTheirList)
+{
+	intlist other{ 1 };
+	{
+		intlist list{ 2,3,4 };
+		list.defragment();
+		other.splice(other.begin(), list);
+		intlist::node_handle nh;
+		list.push_back(5);
+		list.defragment();
+		nh = list.extract(list.begin());
+		other.insert(other.end(), std::move(nh));
+	}
+	EXPECT_TRUE(compareList(other, intlist{ 1,2,3,4,5 }));
+}
+
+using maintainedlist = list<int, list_stats::maintenance>;
+
+TEST(defragment, shouldTriggerOnMaintenanceBelowThreshold)
+{
+	maintainedlist list = makeScattered<maintainedlist>(4096);
+	list.set_defragment_threshold(0.5);
+	EXPECT_FALSE(list.maintain());
+	for (int i = 0; i < 4096; i++)
+	{
+		list.push_back(i);
+		list.pop_back();
+	}
+	EXPECT_LT(list.locality_score(), 0.5);
+	EXPECT_TRUE(list.maintain());
+	EXPECT_GT(list.locality_score(), 0.5);
+	EXPECT_EQ(list.size(), 4096);
+	EXPECT_FALSE(list.maintain());
+}
+
+TEST(defragment, shouldNotKeepIteratorsOutsideMaintenance)
+{
+	maintainedlist list = makeScattered<maintainedlist>(2048);
+	list.set_defragment_threshold(1.0);
+	auto first = list.begin();
+	const int value = *first;
+	for (int i = 0; i < 4096; i++)
+	{
+		list.push_back(i);
+		list.pop_back();
+	}
+	EXPECT_EQ(*first, value);
+	EXPECT_TRUE(first == list.begin());
+}
+
+TEST(defragment, shouldNotPoolTinyBatches)
+{
+	intlist tiny;
+	tiny.append_n(3, [i = 0]() mutable { return i++; });
+	tiny.defragment();
+	EXPECT_EQ(tiny.memory_usage().slabs, 0);
+	EXPECT_TRUE(compareList(tiny, intlist{ 0,1,2 }));
+
+	intlist batch;
+	batch.append_n(intlist::slab_min_nodes, [i = 0]() mutable { return i++; });
+	EXPECT_EQ(batch.memory_usage().slabs, 1);
+}
+
+// memory usage
+
+TEST(memory_usage, shouldBreakDownNodeOverhead)
+{
+	intlist list = makeScattered(100);
+	const auto report = list.memory_usage();
+	EXPECT_EQ(report.nodes, 100);
+	EXPECT_EQ(report.payload_bytes, 100 * sizeof(int));
+	EXPECT_EQ(report.link_bytes, 100 * 2 * sizeof(void*));
+	EXPECT_EQ(report.vptr_bytes, 100 * sizeof(void*));
+	EXPECT_EQ(report.payload_bytes + report.link_bytes + report.vptr_bytes + report.padding_bytes, 100 * intlist::node_bytes);
+	EXPECT_EQ(report.slabs, 0);
+	EXPECT_EQ(report.cached_bytes, 0);
+	EXPECT_GE(report.total_bytes(), 100 * intlist::node_bytes + sizeof(intlist));
+	EXPECT_GT(report.overhead_ratio(), 1.0);
+}
+
+TEST(memory_usage, shouldReportSlabSpareSlotsAsCached)
+{
+	intlist list = makeScattered(100);
+	list.defragment();
+	const auto report = list.memory_usage();
+	EXPECT_EQ(report.slabs, 1);
+	EXPECT_EQ(report.allocator_slack_bytes, 0);
+	EXPECT_GT(report.cached_nodes, 0);
+	EXPECT_TRUE(std::has_single_bit(report.cached_bytes + 100 * intlist::node_bytes));
+	EXPECT_GE(report.cached_bytes, report.cached_nodes * intlist::node_bytes);
+}
+
+TEST(memory_usage, shouldHistogramAdjacentNodeDistances)
+{
+	intlist scattered = makeScattered(1000);
+	const auto before = scattered.memory_usage_detailed();
+	std::size_t hops = 0;
+	for (std::size_t count : before.distance_histogram)
+		hops += count;
+	EXPECT_EQ(hops, 999);
+	EXPECT_GT(before.backward_hops, 0);
+
+	scattered.defragment();
+	const auto after = scattered.memory_usage_detailed();
+	EXPECT_EQ(after.contiguous_hops, 999);
+	EXPECT_EQ(after.backward_hops, 0);
+	EXPECT_EQ(after.distance_histogram[std::bit_width(intlist::node_bytes)], 999);
+
+	EXPECT_EQ(intlist{}.memory_usage_detailed().contiguous_hops, 0);
+}
+
 // remove if
 
 TEST(remove_if, shouldRemoveSucefully)
@@ -1102,6 +1478,164 @@ TEST(remove_if, shouldUpdateListSize)
 	EXPECT_EQ(list.size(), 3);
 }
 
+TEST(remove_if, shouldRemoveConsecutiveMatches)
+{
+	intlist list{ 2,4,1,6,8,10,3,12 };
+	auto removed = list.remove_if(isEven);
+	EXPECT_EQ(removed, 6);
+	EXPECT_TRUE(compareList(list, intlist{ 1,3 }));
+}
+
+// extract if
+
+TEST(extract_if, shouldReturnTheRemovedElementsInOrder)
+{
+	intlist list{ 1,2,3,4,5,6 };
+	intlist extracted = list.extract_if(isEven);
+	EXPECT_TRUE(compareList(list, intlist{ 1,3,5 }));
+	EXPECT_TRUE(compareList(extracted, intlist{ 2,4,6 }));
+}
+
+TEST(extract_if, shouldUpdateBothSizes)
+{
+	intlist list{ 2,4,6,1 };
+	intlist extracted = list.extract_if(isEven);
+	EXPECT_EQ(list.size(), 1);
+	EXPECT_EQ(extracted.size(), 3);
+}
+
+TEST(extract_if, shouldExtractEverything)
+{
+	intlist list{ 2,4,6 };
+	intlist extracted = list.extract_if(isEven);
+	EXPECT_TRUE(list.empty());
+	EXPECT_TRUE(compareList(extracted, intlist{ 2,4,6 }));
+	list.push_back(8);
+	EXPECT_TRUE(compareList(list, intlist{ 8 }));
+}
+
+TEST(extract_if, noProblemIfListEmpty)
+{
+	intlist emptylist;
+	intlist extracted = emptylist.extract_if(isEven);
+	EXPECT_TRUE(extracted.empty());
+}
+
+// erase range
+
+TEST(erase, shouldEraseTheRange)
+{
+	intlist list{ 1,2,3,4,5 };
+	auto first = ++(list.begin());
+	auto last = --(list.end());
+	list.erase(first, last);
+	EXPECT_TRUE(compareList(list, intlist{ 1,5 }));
+	EXPECT_EQ(list.size(), 2);
+}
+
+TEST(erase, shouldReturnLast)
+{
+	intlist list{ 1,2,3 };
+	auto it = list.erase(list.begin(), --(list.end()));
+	EXPECT_EQ(*it, 3);
+}
+
+TEST(erase, shouldEraseEverything)
+{
+	intlist list{ 1,2,3 };
+	list.erase(list.cbegin(), list.cend());
+	EXPECT_TRUE(list.empty());
+}
+
+TEST(erase, noProblemIfRangeEmpty)
+{
+	intlist list{ 1,2,3 };
+	list.erase(list.begin(), list.begin());
+	EXPECT_EQ(list.size(), 3);
+}
+
+TEST(erase, shouldThrowExceptionIfRangeContainsHead)
+{
+	intlist list{ 1,2,3 };
+	EXPECT_THROW(list.erase(--(list.end()), list.begin()), std::runtime_error);
+	EXPECT_EQ(list.size(), 3);
+}
+
+// node handles
+
+TEST(extract, shouldUnlinkTheElementAtIterator)
+{
+	intlist list{ 1,2,3 };
+	auto nh = list.extract(++(list.begin()));
+	EXPECT_EQ(nh.value(), 2);
+	EXPECT_TRUE(compareList(list, intlist{ 1,3 }));
+	EXPECT_EQ(list.size(), 2);
+}
+
+TEST(extract, shouldThrowLengthErrorIfListEmpty)
+{
+	intlist emptylist;
+	EXPECT_THROW(emptylist.extract(emptylist.begin()), std::length_error);
+}
+
+TEST(extract, shouldThrowExceptionIfIteratorPointsToHead)
+{
+	intlist list{ 1,2,3 };
+	EXPECT_THROW(list.extract(list.end()), std::runtime_error);
+}
+
+TEST(insertNodeHandle, shouldInsertIntoAnotherList)
+{
+	intlist list{ 1,2,3 };
+	intlist other{ 7,9 };
+	auto it = other.insert(--(other.end()), list.extract(list.begin()));
+	EXPECT_EQ(*it, 1);
+	EXPECT_TRUE(compareList(other, intlist{ 7,1,9 }));
+	EXPECT_EQ(other.size(), 3);
+	EXPECT_EQ(list.size(), 2);
+}
+
+TEST(insertNodeHandle, shouldLeaveTheHandleEmpty)
+{
+	intlist list{ 1,2,3 };
+	auto nh = list.extract(list.begin());
+	list.insert(list.end(), std::move(nh));
+	EXPECT_TRUE(nh.empty());
+	EXPECT_TRUE(compareList(list, intlist{ 2,3,1 }));
+}
+
+TEST(insertNodeHandle, shouldMoveNodesBetweenListsWithDifferentPolicies)
+{
+	intlist plain{ 1,2,3 };
+	list<int, list_stats::counters> counted{ 7,9 };
+	static_assert(std::is_same_v<intlist::node_handle, list<int, list_stats::counters>::node_handle>);
+
+	counted.reset_stats();
+	counted.insert(counted.begin(), plain.extract(plain.begin()));
+	EXPECT_EQ(counted.front(), 1);
+	EXPECT_EQ(counted.size(), 3);
+	EXPECT_EQ(counted.stats().allocations, 0);
+
+	plain.insert(plain.end(), counted.extract(--counted.end()));
+	EXPECT_TRUE(compareList(plain, intlist{ 2,3,9 }));
+}
+
+TEST(insertNodeHandle, shouldThrowExceptionIfHandleEmpty)
+{
+	intlist list{ 1,2,3 };
+	EXPECT_THROW(list.insert(list.end(), intlist::node_handle()), std::invalid_argument);
+}
+
+TEST_F(testResourceList, extractAndInsertShouldNotCopyOrMove)
+{
+	list<testResource> other;
+	listForTesting.emplace_back(1);
+	other.insert(other.end(), listForTesting.extract(listForTesting.begin()));
+	EXPECT_EQ(testResource::copyConstructor, 0);
+	EXPECT_EQ(testResource::movementConstructor, 0);
+	EXPECT_EQ(other.size(), 1);
+}
+
 // constructor using iterators
 
 TEST(constructorUsingIterator, shouldCreateTheListSuccefully)
@@ -1231,4 +1765,431 @@ TEST(sort, ifSizeIsOne)
 	intlist list{ 1 };
 	list.sort();
 	EXPECT_TRUE(compareList(list,intlist{1}));
+}
+
+TEST(sort, shouldMergeSortByRelinking)
+{
+	intlist list{ 0,6,2,3,9,7,1,4,5,8 };
+	const int* addressOfSix = &*std::next(list.begin());
+	list.merge_sort();
+	EXPECT_TRUE(compareList(list, intlist{ 0,1,2,3,4,5,6,7,8,9 }));
+	EXPECT_EQ(&*std::next(list.begin(), 6), addressOfSix);
+	EXPECT_EQ(*list.rbegin(), 9);
+	EXPECT_EQ(*std::next(list.rbegin()), 8);
+
+	list.merge_sort(std::greater<>{});
+	EXPECT_TRUE(compareList(list, intlist{ 9,8,7,6,5,4,3,2,1,0 }));
+}
+
+TEST(sort, shouldMergeSortStably)
+{
+	list<std::pair<int, int>> pairs;
+	for (int i = 0; i < 100; i++)
+		pairs.push_back({ i % 3, i });
+	pairs.merge_sort([](const auto& a, const auto& b) { return a.first < b.first; });
+
+	int previousKey = -1;
+	int previousOrder = -1;
+	for (const auto& [key, order] : pairs)
+	{
+		if (key == previousKey)
+			EXPECT_LT(previousOrder, order);
+		else
+			EXPECT_GT(key, previousKey);
+		previousKey = key;
+		previousOrder = order;
+	}
+}
+
+TEST(sort, shouldRadixSortByRelinking)
+{
+	std::mt19937 generator(3);
+	list<std::uint32_t> values;
+	std::vector<std::uint32_t> expected;
+	for (int i = 0; i < 5000; i++)
+	{
+		values.push_back(generator() & 0xffffff);
+		expected.push_back(values.back());
+	}
+	const std::uint32_t* addressOfFirst = &*values.begin();
+	values.radix_sort();
+	std::sort(expected.begin(), expected.end());
+
+	EXPECT_TRUE(std::equal(values.begin(), values.end(), expected.begin(), expected.end()));
+	EXPECT_EQ(*values.rbegin(), expected.back());
+	EXPECT_EQ(*std::next(values.rbegin()), expected[expected.size() - 2]);
+	EXPECT_EQ(&*std::find(values.begin(), values.end(), *addressOfFirst), addressOfFirst);
+	EXPECT_EQ(values.size(), 5000);
+}
+
+TEST(sort, shouldRadixSortSignedKeysStably)
+{
+	list<std::pair<int, int>, list_stats::counters> pairs;
+	for (int i = 0; i < 30000; i++)
+		pairs.push_back({ i % 7 - 3, i });
+	pairs.reset_stats();
+	pairs.radix_sort([](const auto& e) { return e.first; });
+	EXPECT_EQ(pairs.stats().comparisons, 0);
+	EXPECT_GT(pairs.stats().relinks, 0);
+
+	std::pair<int, int> previous{ std::numeric_limits<int>::min(), -1 };
+	for (const auto& current : pairs)
+	{
+		if (current.first == previous.first)
+			EXPECT_LT(previous.second, current.second);
+		else
+			EXPECT_GT(current.first, previous.first);
+		previous = current;
+	}
+	EXPECT_EQ((*pairs.begin()).first, -3);
+
+	list<long long, list_stats::counters> wide{ 5, -1LL << 40, 3, 1LL << 50 };
+	wide.radix_sort();
+	EXPECT_GT(wide.stats().comparisons, 0);
+	EXPECT_EQ(*wide.begin(), -1LL << 40);
+	EXPECT_EQ(*wide.rbegin(), 1LL << 50);
+}
+
+TEST(sort, shouldRadixSortSmallListsAndEnums)
+{
+	enum class level : std::int8_t { low = -1, mid = 0, high = 1 };
+	list<level> levels{ level::high, level::low, level::mid, level::low };
+	levels.radix_sort();
+	const std::vector<level> expected{ level::low, level::low, level::mid, level::high };
+	EXPECT_TRUE(std::equal(levels.begin(), levels.end(), expected.begin(), expected.end()));
+
+	intlist list{ 3,-2,1 };
+	list.radix_sort();
+	EXPECT_TRUE(compareList(list, intlist{ -2,1,3 }));
+	intlist empty;
+	empty.radix_sort();
+	EXPECT_TRUE(empty.empty());
+}
+
+// partial sort and selection
+
+TEST(partial_sort, shouldRelinkSmallestToFrontInOrder)
+{
+	intlist list{ 9,3,7,1,8,2,6,0,5,4 };
+	const int* addressOfOne = &*std::next(list.begin(), 3);
+	list.partial_sort(3);
+	EXPECT_TRUE(compareList(list, intlist{ 0,1,2,9,3,7,8,6,5,4 }));
+	EXPECT_EQ(&*std::next(list.begin()), addressOfOne);
+	EXPECT_EQ(*list.rbegin(), 4);
+	EXPECT_EQ(list.size(), 10);
+
+	list.partial_sort(100, std::greater<>{});
+	EXPECT_TRUE(compareList(list, intlist{ 9,8,7,6,5,4,3,2,1,0 }));
+	list.partial_sort(0);
+	EXPECT_TRUE(compareList(list, intlist{ 9,8,7,6,5,4,3,2,1,0 }));
+}
+
+TEST(partial_sort, shouldProjectKeysOnceAndKeepTiesStable)
+{
+	struct record
+	{
+		int key;
+		int order;
+	};
+	list<record> records;
+	for (int i = 0; i < 50; i++)
+		records.push_back({ (i * 7) % 5, i });
+
+	int projections = 0;
+	records.partial_sort(12, std::less<>{}, [&](const record& r) { ++projections; return r.key; });
+	EXPECT_EQ(projections, 50);
+
+	int index = 0;
+	record previous{ -1, -1 };
+	for (const record& r : records)
+	{
+		if (index < 10)
+		{
+			EXPECT_EQ(r.key, 0);
+		}
+		else if (index < 12)
+		{
+			EXPECT_EQ(r.key, 1);
+		}
+		if (index < 12 && r.key == previous.key)
+		{
+			EXPECT_GT(r.order, previous.order);
+		}
+		previous = r;
+		++index;
+	}
+}
+
+TEST(partial_sort, shouldAcceptKeysWithoutDefaultConstructor)
+{
+	struct priority
+	{
+		explicit priority(int value_) : value(value_) {}
+		bool operator<(const priority& other) const { return value < other.value; }
+		int value;
+	};
+
+	intlist list{ 4,9,1,7,3,8 };
+	list.partial_sort(3, std::less<>{}, [](int e) { return priority(-e); });
+	EXPECT_TRUE(compareList(list, intlist{ 9,8,7,4,1,3 }));
+	EXPECT_EQ(*list.select(0, std::less<>{}, [](int e) { return priority(e); }), 1);
+}
+
+TEST(partial_sort, shouldExtractTopKByStealingNodes)
+{
+	intlist list{ 4,9,1,7,3,8 };
+	const int* addressOfNine = &*std::next(list.begin());
+	intlist top = list.extract_top_k(2, std::greater<>{});
+	EXPECT_TRUE(compareList(top, intlist{ 9,8 }));
+	EXPECT_EQ(&*top.begin(), addressOfNine);
+	EXPECT_TRUE(compareList(list, intlist{ 4,1,7,3 }));
+	EXPECT_EQ(list.size(), 4);
+	EXPECT_EQ(top.size(), 2);
+
+	intlist rest = list.extract_top_k(10);
+	EXPECT_TRUE(compareList(rest, intlist{ 1,3,4,7 }));
+	EXPECT_TRUE(list.empty());
+}
+
+TEST(partial_sort, shouldSelectWithoutReordering)
+{
+	intlist list{ 5,2,8,2,9,1 };
+	EXPECT_EQ(*list.select(0), 1);
+	EXPECT_EQ(*list.select(2), 2);
+	EXPECT_EQ(list.select(1), std::next(list.begin()));
+	EXPECT_EQ(*list.select(5), 9);
+	EXPECT_TRUE(compareList(list, intlist{ 5,2,8,2,9,1 }));
+	EXPECT_THROW((void)list.select(6), std::out_of_range);
+}
+
+TEST(partial_sort, shouldPartitionAroundNthElement)
+{
+	intlist list{ 6,3,9,0,7,4,1,8,2,5 };
+	const int* addressOfFour = &*std::next(list.begin(), 5);
+	auto nth = list.nth_element(4);
+	EXPECT_EQ(*nth, 4);
+	EXPECT_EQ(&*nth, addressOfFour);
+	EXPECT_EQ(nth, std::next(list.begin(), 4));
+	EXPECT_TRUE(compareList(list, intlist{ 3,0,1,2,4,6,9,7,8,5 }));
+	EXPECT_EQ(*list.rbegin(), 5);
+	EXPECT_EQ(list.size(), 10);
+}
+
+// stats
+
+TEST(stats, shouldCountAllocationsAndDeallocations)
+{
+	list<int, list_stats::counters> list;
+	for (int i = 0; i < 10; i++)
+		list.push_back(i);
+	list.pop_front();
+	list.pop(list.begin());
+	list.clear();
+
+	const auto report = list.stats();
+	EXPECT_EQ(report.allocations, 10);
+	EXPECT_EQ(report.deallocations, 10);
+
+	list.reset_stats();
+	EXPECT_EQ(list.stats().allocations, 0);
+}
+
+TEST(stats, shouldCountWalksComparisonsAndRelinks)
+{
+	list<int, list_stats::counters> list;
+	for (int i = 0; i < 100; i++)
+		list.push_back((i * 37) % 100);
+	list.reset_stats();
+
+	EXPECT_TRUE(list.contains(list.back()));
+	EXPECT_EQ(list.stats().nodes_walked, 100);
+
+	list.merge_sort();
+	EXPECT_GT(list.stats().comparisons, 100);
+	EXPECT_LT(list.stats().comparisons, 100 * 7);
+	EXPECT_GT(list.stats().relinks, 0);
+
+	list.reset_stats();
+	EXPECT_EQ(list.remove_if([](int e) { return e < 10; }), 10);
+	EXPECT_EQ(list.stats().remove_if_visits, 100);
+	EXPECT_EQ(list.stats().relinks, 10);
+}
+
+TEST(stats, shouldRecordLatencyHistogramsWhenTimed)
+{
+	list<int, list_stats::timed_counters> list;
+	for (int i = 0; i < 50; i++)
+		list.push_front(i);
+	list.sort();
+	list.pop_back();
+
+	const auto report = list.stats();
+	EXPECT_EQ(report.latency_of(list_stats::operation::insert).calls, 50);
+	EXPECT_EQ(report.latency_of(list_stats::operation::sort).calls, 1);
+	EXPECT_EQ(report.latency_of(list_stats::operation::erase).calls, 1);
+	EXPECT_GT(report.latency_of(list_stats::operation::sort).total_ns, 0);
+	EXPECT_LE(report.latency_of(list_stats::operation::insert).percentile_ns(0.5), report.latency_of(list_stats::operation::insert).max_ns);
+	EXPECT_EQ(report.latency_of(list_stats::operation::splice).calls, 0);
+}
+
+TEST(stats, shouldKeepCountersOnSeparateCacheLinesAndCostNothingWhenDisabled)
+{
+	EXPECT_GE(sizeof(list_stats::counters), list_stats::counter_count * list_stats::cache_line);
+	EXPECT_EQ(sizeof(intlist), 3 * sizeof(void*) + sizeof(std::size_t));
+	EXPECT_LT(sizeof(intlist), sizeof(list<int, list_stats::counters>));
+	EXPECT_EQ(alignof(list<int, list_stats::counters>), list_stats::cache_line);
+
+	list<int, list_stats::counters> counted{ 1, 2, 3 };
+	list<int, list_stats::counters> copy(counted);
+	EXPECT_EQ(copy.stats().allocations, 3);
+}
+
+// fingerprint
+
+using fingerprinted = list<int, list_stats::fingerprint>;
+
+namespace
+{
+	std::uint64_t recomputedFingerprint(const fingerprinted& target)
+	{
+		intlist plain;
+		for (int e : target)
+			plain.push_back(e);
+		return plain.fingerprint();
+	}
+}
+
+TEST(fingerprint, shouldMatchForEqualListsBuiltDifferently)
+{
+	fingerprinted pushed{ 1,2,3,4,5 };
+
+	fingerprinted built;
+	built.push_front(5);
+	built.push_front(1);
+	built.emplace(std::next(built.begin()), 3);
+	built.emplace(std::next(built.begin()), 2);
+	built.emplace(std::prev(built.end()), 4);
+
+	fingerprinted spliced{ 1,5 };
+	fingerprinted middle;
+	middle.append_n(3, [i = 2]() mutable { return i++; });
+	spliced.splice(spliced.begin(), middle);
+
+	EXPECT_EQ(pushed.fingerprint(), built.fingerprint());
+	EXPECT_EQ(pushed.fingerprint(), spliced.fingerprint());
+	EXPECT_EQ(pushed.fingerprint(), (intlist{ 1,2,3,4,5 }).fingerprint());
+	EXPECT_EQ(middle.fingerprint(), 0);
+	EXPECT_EQ(fingerprinted{}.fingerprint(), 0);
+	EXPECT_EQ(pushed, spliced);
+}
+
+TEST(fingerprint, shouldCoverNodesAppendedBeforeGeneratorThrows)
+{
+	fingerprinted list{ -1 };
+	const std::size_t count = 2 * fingerprinted::slab_min_nodes;
+	EXPECT_THROW(list.append_n(count, [i = 0]() mutable
+		{
+			if (i == 70)
+				throw std::runtime_error("generator failed");
+			return i++;
+		}), std::runtime_error);
+
+	EXPECT_EQ(list.size(), 71);
+	EXPECT_EQ(list.back(), 69);
+	EXPECT_EQ(list.fingerprint(), recomputedFingerprint(list));
+}
+
+TEST(fingerprint, shouldBeOrderSensitive)
+{
+	fingerprinted forward{ 1,2,3 };
+	fingerprinted backward{ 3,2,1 };
+	EXPECT_NE(forward.fingerprint(), backward.fingerprint());
+	EXPECT_FALSE(forward == backward);
+	EXPECT_NE(std::hash<intlist>{}(intlist{ 1,2 }), std::hash<intlist>{}(intlist{ 2,1 }));
+}
+
+TEST(fingerprint, shouldStayConsistentAcrossMutations)
+{
+	fingerprinted list;
+	for (int i = 0; i < 200; i++)
+		list.push_back((i * 37) % 101);
+
+	list.pop_front();
+	list.pop_back();
+	list.pop(std::next(list.begin(), 50));
+	list.erase(std::next(list.begin(), 10), std::next(list.begin(), 30));
+	auto handle = list.extract(std::next(list.begin(), 5));
+	list.insert(std::next(list.begin(), 70), std::move(handle));
+	EXPECT_EQ(list.fingerprint(), recomputedFingerprint(list));
+
+	fingerprinted removed = list.extract_if([](int e) { return e % 3 == 0; });
+	EXPECT_EQ(list.fingerprint(), recomputedFingerprint(list));
+	EXPECT_EQ(removed.fingerprint(), recomputedFingerprint(removed));
+
+	fingerprinted other{ 7,8,9 };
+	list.splice(std::next(list.begin(), 3), other);
+	EXPECT_EQ(list.fingerprint(), recomputedFingerprint(list));
+	EXPECT_EQ(other.fingerprint(), 0);
+
+	list.merge_sort();
+	EXPECT_EQ(list.fingerprint(), recomputedFingerprint(list));
+	list.partial_sort(5, std::greater<>{});
+	EXPECT_EQ(list.fingerprint(), recomputedFingerprint(list));
+	list.for_each([](int& e) { e *= 2; });
+	EXPECT_EQ(list.fingerprint(), recomputedFingerprint(list));
+
+	fingerprinted moved(std::move(list));
+	EXPECT_EQ(moved.fingerprint(), recomputedFingerprint(moved));
+	EXPECT_EQ(list.fingerprint(), 0);
+	moved.clear();
+	EXPECT_EQ(moved.fingerprint(), 0);
+}
+
+TEST(fingerprint, shouldOnlyAllowWritesThroughUpdate)
+{
+	static_assert(std::is_same_v<decltype(std::declval<fingerprinted&>().front()), const int&>);
+	static_assert(std::is_same_v<fingerprinted::iterator::reference, const int&>);
+	static_assert(std::is_same_v<fingerprinted::reverse_iterator::reference, const int&>);
+	static_assert(std::is_same_v<intlist::iterator::reference, int&>);
+
+	fingerprinted list{ 1,2,3 };
+	list.update(list.begin(), [](int& value) { value = 9; });
+	list.update(std::prev(list.end()), [](int& value) { value = 7; });
+	EXPECT_EQ(list.fingerprint(), recomputedFingerprint(list));
+	EXPECT_TRUE(list == (fingerprinted{ 9,2,7 }));
+	EXPECT_EQ(std::hash<fingerprinted>{}(list), std::hash<intlist>{}(intlist{ 9,2,7 }));
+
+	EXPECT_THROW(list.update(std::next(list.begin()), [](int& value) { value = 4; throw std::runtime_error("rejected"); }), std::runtime_error);
+	EXPECT_EQ(list.fingerprint(), recomputedFingerprint(list));
+	EXPECT_THROW(list.update(list.end(), [](int&) {}), std::runtime_error);
+}
+
+TEST(fingerprint, shouldHashListsForUnorderedContainers)
+{
+	std::unordered_set<fingerprinted> seen;
+	seen.insert(fingerprinted{ 1,2,3 });
+	seen.insert(fingerprinted{ 3,2,1 });
+	seen.insert(fingerprinted{ 1,2,3 });
+	EXPECT_EQ(seen.size(), 2);
+	EXPECT_TRUE(seen.contains(fingerprinted{ 3,2,1 }));
+	EXPECT_EQ(std::hash<fingerprinted>{}(fingerprinted{ 4,5 }), std::hash<intlist>{}(intlist{ 4,5 }));
+}
+
+TEST(fingerprint, shouldCombineWithCountersAndMaintenance)
+{
+	using combined = list<int, list_stats::combine<list_stats::counters, list_stats::fingerprint, list_stats::maintenance>>;
+	combined values{ 3, 1, 2 };
+	values.push_back(4);
+	static_assert(std::is_same_v<decltype(values.front()), const int&>);
+	EXPECT_EQ(values.stats().allocations, 4);
+	EXPECT_EQ(values.fingerprint(), (fingerprinted{ 3,1,2,4 }).fingerprint());
+
+	values.sort();
+	EXPECT_EQ(values.fingerprint(), (fingerprinted{ 1,2,3,4 }).fingerprint());
+	EXPECT_GT(values.stats().comparisons, 0);
+
+	values.set_defragment_threshold(0.5);
+	EXPECT_FALSE(values.maintain());
+	EXPECT_FALSE(values == combined({ 1,2,3,5 }));
+	EXPECT_EQ(sizeof(list<int, list_stats::maintenance>), sizeof(intlist) + sizeof(list_stats::maintenance));
 }
\ No newline at end of file
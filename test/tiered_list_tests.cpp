@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+#include "../list/tiered_list.h"
+#include <filesystem>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using inttieredlist = tiered_list<int>;
+
+namespace
+{
+	std::filesystem::path spillPath(const std::string& name)
+	{
+		return std::filesystem::path(testing::TempDir()) / ("tiered_list_" + name + ".spill");
+	}
+
+	tiered_list_options smallOptions()
+	{
+		tiered_list_options options;
+		options.segment_elements = 100;
+		options.max_resident_segments = 4;
+		options.hot_segments = 1;
+		return options;
+	}
+
+	std::vector<int> contents(const inttieredlist& list)
+	{
+		return std::vector<int>(list.begin(), list.end());
+	}
+}
+
+// paging
+
+TEST(tiered_list_paging, shouldSpillColdSegmentsAndKeepLimit)
+{
+	inttieredlist list(spillPath("spill"), smallOptions());
+	for (int i = 0; i < 10000; i++)
+		list.push_back(i);
+
+	EXPECT_EQ(list.size(), 10000);
+	EXPECT_EQ(list.stats().segments, 100);
+	EXPECT_LE(list.stats().resident_segments, 4);
+	EXPECT_GE(list.stats().page_outs, 96);
+	EXPECT_EQ(list.stats().page_ins, 0);
+	EXPECT_EQ(list.front(), 0);
+	EXPECT_EQ(list.back(), 9999);
+}
+
+TEST(tiered_list_paging, shouldPageInWhenIterationReachesColdSegments)
+{
+	inttieredlist list(spillPath("iterate"), smallOptions());
+	for (int i = 0; i < 5000; i++)
+		list.push_back(i);
+	list.reset_stats();
+
+	std::vector<int> expected(5000);
+	std::iota(expected.begin(), expected.end(), 0);
+	EXPECT_EQ(contents(list), expected);
+	EXPECT_GE(list.stats().page_ins, 48);
+	EXPECT_LE(list.stats().resident_segments, 4);
+	EXPECT_LT(list.stats().bytes_written * 10, list.stats().bytes_read);
+
+	EXPECT_EQ(list.accumulate(0LL), 12497500LL);
+	EXPECT_EQ(list.count_if([](int e) { return e % 2 == 0; }), 2500);
+	EXPECT_TRUE(list.contains(2500));
+	EXPECT_FALSE(list.contains(5000));
+}
+
+TEST(tiered_list_paging, shouldPersistModificationsMadeThroughIterators)
+{
+	inttieredlist list(spillPath("modify"), smallOptions());
+	for (int i = 0; i < 2000; i++)
+		list.push_back(i);
+
+	for (int& e : list)
+		e *= 2;
+
+	EXPECT_GT(list.stats().bytes_written, 0);
+	EXPECT_EQ(list.accumulate(0LL), 2LL * 1999000LL);
+}
+
+TEST(tiered_list_paging, shouldNotRewriteSegmentsThatWereOnlyRead)
+{
+	inttieredlist list(spillPath("readonly"), smallOptions());
+	for (int i = 0; i < 2000; i++)
+		list.push_back(i);
+	for (int pass = 0; pass < 2; pass++)
+		EXPECT_EQ(list.accumulate(0LL), 1999000LL);
+	list.reset_stats();
+
+	long long total = 0;
+	for (int& e : list)
+		total += e;
+	(void)list.front();
+	EXPECT_EQ(total, 1999000LL);
+	EXPECT_EQ(list.stats().bytes_written, 0);
+	EXPECT_GT(list.stats().page_outs, 0);
+}
+
+TEST(tiered_list_paging, shouldReuseAndCompactSpillExtents)
+{
+	const auto path = spillPath("extents");
+	inttieredlist list(path, smallOptions());
+	for (int i = 0; i < 2000; i++)
+		list.push_back(i);
+	for (int& e : list)
+		e *= 64;
+	for (int& e : list)
+		e /= 64;
+	const std::size_t settled = list.stats().spill_bytes;
+
+	for (int round = 0; round < 20; round++)
+		for (int& e : list)
+			e = round % 2 ? e / 64 : e * 64;
+
+	EXPECT_EQ(list.stats().spill_bytes, std::filesystem::file_size(path));
+	EXPECT_LE(list.stats().stale_bytes * 2, list.stats().spill_bytes);
+	EXPECT_LE(list.stats().spill_bytes, settled);
+	EXPECT_EQ(list.accumulate(0LL), 1999000LL);
+}
+
+TEST(tiered_list_paging, shouldKeepIteratorsValidWhenTheirSegmentIsPagedOut)
+{
+	inttieredlist list(spillPath("reresolve"), smallOptions());
+	for (int i = 0; i < 2000; i++)
+		list.push_back(i);
+
+	auto it = std::next(list.cbegin(), 550);
+	EXPECT_EQ(*it, 550);
+	const std::size_t pageOuts = list.stats().page_outs;
+	for (auto other = std::next(list.cbegin(), 1000); other != list.cend(); ++other)
+		(void)*other;
+	EXPECT_GT(list.stats().page_outs, pageOuts);
+
+	EXPECT_EQ(*it, 550);
+	++it;
+	EXPECT_EQ(*it, 551);
+	it = std::next(it, 49);
+	EXPECT_EQ(*it, 600);
+	EXPECT_TRUE(std::next(it, 1400) == list.cend());
+}
+
+TEST(tiered_list_paging, shouldPageInNewEndsWhenPopping)
+{
+	inttieredlist list(spillPath("pop"), smallOptions());
+	for (int i = 0; i < 1000; i++)
+		list.push_back(i);
+
+	for (int i = 0; i < 450; i++)
+		list.pop_front();
+	for (int i = 0; i < 450; i++)
+		list.pop_back();
+
+	EXPECT_EQ(list.size(), 100);
+	EXPECT_EQ(list.front(), 450);
+	EXPECT_EQ(list.back(), 549);
+	EXPECT_GT(list.stats().page_ins, 0);
+
+	while (!list.empty())
+		list.pop_back();
+	EXPECT_EQ(list.stats().segments, 0);
+	EXPECT_THROW(list.pop_front(), std::length_error);
+	EXPECT_THROW((void)list.front(), std::length_error);
+}
+
+TEST(tiered_list_paging, shouldPushAtBothEnds)
+{
+	inttieredlist list(spillPath("both"), smallOptions());
+	for (int i = 0; i < 500; i++)
+	{
+		list.push_back(i);
+		list.push_front(-i - 1);
+	}
+
+	const auto values = contents(list);
+	ASSERT_EQ(values.size(), 1000);
+	for (int i = 0; i < 1000; i++)
+		EXPECT_EQ(values[i], i - 500);
+}
+
+TEST(tiered_list_paging, shouldSpillCustomSerializedValues)
+{
+	tiered_list<std::string> list(spillPath("strings"), smallOptions());
+	for (int i = 0; i < 1000; i++)
+		list.push_back("value " + std::to_string(i));
+
+	int expected = 0;
+	for (const std::string& e : std::as_const(list))
+		EXPECT_EQ(e, "value " + std::to_string(expected++));
+	EXPECT_EQ(expected, 1000);
+}
+
+TEST(tiered_list_paging, shouldClearAndRemoveSpillFile)
+{
+	const auto path = spillPath("clear");
+	{
+		inttieredlist list(path, smallOptions());
+		for (int i = 0; i < 1000; i++)
+			list.push_back(i);
+		EXPECT_GT(std::filesystem::file_size(path), 0);
+		list.clear();
+		EXPECT_TRUE(list.empty());
+		EXPECT_EQ(std::filesystem::file_size(path), 0);
+		list.push_back(1);
+		EXPECT_EQ(contents(list), (std::vector<int>{ 1 }));
+	}
+	EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TEST(tiered_list_paging, shouldRejectInvalidOptions)
+{
+	tiered_list_options options;
+	options.max_resident_segments = 2;
+	EXPECT_THROW(inttieredlist(spillPath("invalid"), options), std::invalid_argument);
+	options = {};
+	options.segment_elements = 0;
+	EXPECT_THROW(inttieredlist(spillPath("invalid"), options), std::invalid_argument);
+}
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+#include "../list/xor_list.h"
+#include <string>
+
+using intxorlist = xor_list<int>;
+
+namespace
+{
+	testing::AssertionResult compareList(const intxorlist& list, const intxorlist& list2)
+	{
+		if (list == list2)
+			return testing::AssertionSuccess();
+		else
+		{
+			auto fillStringWithList = [](std::string& str, const intxorlist& target)
+				{
+					for (int e : target)
+						str.append(std::to_string(e) + " ");
+				};
+
+			std::string list1String;
+			std::string list2String;
+
+			fillStringWithList(list1String, list);
+			fillStringWithList(list2String, list2);
+
+			return testing::AssertionFailure() << "List 1: " << list1String
+				<< " List2: " << list2String;
+		}
+	}
+
+	auto isEven = [](int e) {return e % 2 == 0; };
+}
+
+// push and pop
+
+TEST(xor_list_push, shouldPushOnBothEnds)
+{
+	intxorlist list;
+	list.push_back(2);
+	list.push_front(1);
+	list.emplace_back(3);
+	EXPECT_TRUE(compareList(list, intxorlist{ 1,2,3 }));
+	EXPECT_EQ(list.size(), 3);
+}
+
+TEST(xor_list_pop, shouldPopBothEnds)
+{
+	intxorlist list{ 1,2,3,4 };
+	list.pop_back();
+	list.pop_front();
+	EXPECT_TRUE(compareList(list, intxorlist{ 2,3 }));
+	list.pop_back();
+	list.pop_back();
+	EXPECT_TRUE(list.empty());
+	list.push_back(5);
+	EXPECT_EQ(list.front(), 5);
+	EXPECT_EQ(list.back(), 5);
+}
+
+TEST(xor_list_pop, shouldThrowLengthErrorIfEmpty)
+{
+	intxorlist list;
+	EXPECT_THROW(list.pop_back(), std::length_error);
+	EXPECT_THROW(list.pop_front(), std::length_error);
+	EXPECT_THROW(list.back(), std::length_error);
+}
+
+TEST(xor_list_copy, shouldCopyAndMove)
+{
+	intxorlist list{ 1,2,3 };
+	intxorlist copy = list;
+	intxorlist moved = std::move(list);
+	EXPECT_TRUE(compareList(copy, moved));
+	EXPECT_TRUE(list.empty());
+}
+
+// iterators
+
+TEST(xor_list_iterator, shouldTraverseBothDirections)
+{
+	intxorlist list{ 1,2,3 };
+	auto it = list.begin();
+	EXPECT_EQ(*it, 1);
+	EXPECT_EQ(*++it, 2);
+	EXPECT_EQ(*++it, 3);
+	EXPECT_TRUE(++it == list.end());
+	EXPECT_EQ(*--it, 3);
+	EXPECT_EQ(*--(list.end()), 3);
+}
+
+TEST(xor_list_iterator, reverseIteratorShouldWalkBackwards)
+{
+	intxorlist list{ 1,2,3 };
+	intxorlist reversed;
+	for (auto it = list.rbegin(); it != list.rend(); ++it)
+		reversed.push_back(*it);
+	EXPECT_TRUE(compareList(reversed, intxorlist{ 3,2,1 }));
+}
+
+TEST(xor_list_iterator, shouldThrowExceptionIfTriesToGetHeadValue)
+{
+	intxorlist list{ 1 };
+	EXPECT_THROW(*list.end(), std::runtime_error);
+}
+
+// positional operations
+
+TEST(xor_list_insert, shouldInsertBeforeTheIteratorGiven)
+{
+	intxorlist list{ 1,3 };
+	auto it = list.insert(++list.begin(), 2);
+	EXPECT_EQ(*it, 2);
+	EXPECT_EQ(*++it, 3);
+	EXPECT_TRUE(compareList(list, intxorlist{ 1,2,3 }));
+}
+
+TEST(xor_list_insert, shouldInsertUsingReverseIterator)
+{
+	intxorlist list{ 1,3 };
+	list.insert(list.rbegin(), 4);
+	list.insert(list.rend(), 0);
+	EXPECT_TRUE(compareList(list, intxorlist{ 0,1,3,4 }));
+}
+
+TEST(xor_list_pop, shouldPopAtIteratorAndReturnNext)
+{
+	intxorlist list{ 1,2,3 };
+	auto it = list.pop(++list.begin());
+	EXPECT_EQ(*it, 3);
+	EXPECT_TRUE(compareList(list, intxorlist{ 1,3 }));
+	auto rit = list.pop(list.rbegin());
+	EXPECT_EQ(*rit, 1);
+	EXPECT_TRUE(compareList(list, intxorlist{ 1 }));
+	EXPECT_THROW(list.pop(list.end()), std::runtime_error);
+}
+
+// splice
+
+TEST(xor_list_splice, shouldSpliceAfterWhere)
+{
+	intxorlist list{ 1,2,3 };
+	intxorlist splicedlist{ 9,8,7 };
+	list.splice(list.begin(), splicedlist);
+	EXPECT_TRUE(compareList(list, intxorlist{ 1,9,8,7,2,3 }));
+	EXPECT_EQ(list.size(), 6);
+	EXPECT_TRUE(splicedlist.empty());
+}
+
+TEST(xor_list_splice, shouldSpliceAtTheEnds)
+{
+	intxorlist list{ 1,2 };
+	intxorlist back{ 3 };
+	intxorlist front{ 0 };
+	list.splice(--list.end(), back);
+	list.splice(list.end(), front);
+	EXPECT_TRUE(compareList(list, intxorlist{ 0,1,2,3 }));
+	EXPECT_EQ(*list.rbegin(), 3);
+}
+
+TEST(xor_list_splice, ifCurrentListIsEmpty)
+{
+	intxorlist list;
+	intxorlist newlist{ 1,2,3 };
+	list.splice(list.end(), newlist);
+	EXPECT_TRUE(compareList(list, intxorlist{ 1,2,3 }));
+}
+
+// traversal
+
+TEST(xor_list_traversal, findCountAccumulate)
+{
+	intxorlist list{ 1,2,3,4 };
+	EXPECT_EQ(*list.find(3), 3);
+	EXPECT_TRUE(list.find(7) == list.end());
+	EXPECT_TRUE(list.contains(4));
+	EXPECT_EQ(list.count_if(isEven), 2);
+	EXPECT_EQ(list.accumulate(0), 10);
+}